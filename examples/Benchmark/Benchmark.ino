@@ -0,0 +1,192 @@
+/**
+ * @file    Benchmark.ino
+ * @brief   CR95HF read performance benchmark
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ *
+ * Reproducible baseline for driver, baud rate and transport changes.
+ * Measures:
+ * - begin() startup time
+ * - Time to first UID after begin()
+ * - UIDs per second with back-to-back reads
+ * - p50 / p99 latency per phase (REQA/WUPA, anticollision, select) and per
+ *   complete read, separately for 4-byte and 7-byte UIDs
+ * - CPU busy fraction of the polling core
+ *
+ * Procedure: put a tag on the antenna, then reset the board. Swap tags
+ * (4-byte, then 7-byte) and send any character to run again. Results are
+ * printed as plain text, one value per line, easy to diff between runs.
+ *
+ * Hardware Setup (ESP32-C6):
+ * - GPIO1 = RX (connect to CR95HF TXD)
+ * - GPIO2 = TX (connect to CR95HF RXD)
+ * - CR95HF SSI_0 and SSI_1 tied to GND (UART mode)
+ *
+ * @note Adjust pin definitions and BENCH_BAUD for your hardware
+ */
+
+#include <CR95HF.h>
+#include <CR95HF_Bench.h>
+
+// ============================================================================
+// Configuration - Adjust for your hardware
+// ============================================================================
+
+#define NFC_RX_PIN      1       // RX pin (from CR95HF TXD)
+#define NFC_TX_PIN      2       // TX pin (to CR95HF RXD)
+#define NFC_BAUD        57600   // CR95HF power-up baud rate
+
+#define BENCH_BAUD      0       // Baud rate to switch to (0 = keep 57600)
+#define BENCH_RX_EVENTS true    // Event-driven receive (lower CPU load)
+#define BENCH_SECONDS   10      // Duration of the throughput run
+#define BENCH_FIRST_MS  5000    // Give up waiting for the first UID after this
+
+CR95HF nfc(Serial1, NFC_RX_PIN, NFC_TX_PIN, NFC_BAUD);
+CR95HF_CpuLoad cpu;
+
+/// Latency samplers for one UID size
+struct PhaseSamplers {
+    CR95HF_LatencySampler wake;
+    CR95HF_LatencySampler anticoll;
+    CR95HF_LatencySampler select;
+    CR95HF_LatencySampler total;
+
+    void clear() { wake.clear(); anticoll.clear(); select.clear(); total.clear(); }
+};
+
+PhaseSamplers uid4;     // 4-byte UID reads
+PhaseSamplers uid7;     // 7-byte UID reads
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+/**
+ * @brief Print p50 / p99 / max of one sampler
+ */
+void printLatency(const char* name, CR95HF_LatencySampler& s) {
+    Serial.printf("  %-9s n=%-6lu p50=%6lu us  p99=%6lu us  max=%6lu us\n", name,
+                  (unsigned long)s.count(), (unsigned long)s.percentile(50),
+                  (unsigned long)s.percentile(99), (unsigned long)s.maxUs());
+}
+
+/**
+ * @brief Print all samplers of one UID size
+ */
+void printPhases(const char* title, PhaseSamplers& p) {
+    if (p.total.count() == 0) return;
+    Serial.println(title);
+    printLatency("wake", p.wake);
+    printLatency("anticoll", p.anticoll);
+    printLatency("select", p.select);
+    printLatency("read", p.total);
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+/**
+ * @brief Run one complete benchmark pass
+ */
+void runBenchmark() {
+    uint8_t uid[10];
+    uint8_t uidLen = 0, sak = 0;
+
+    Serial.println();
+    Serial.println("=== CR95HF Benchmark ===");
+
+    // begin() startup time
+    uint32_t t0 = micros();
+    bool ok = nfc.begin(false, BENCH_BAUD);
+    uint32_t beginUs = micros() - t0;
+    if (!ok) {
+        Serial.println("begin() FAILED - check wiring");
+        return;
+    }
+    nfc.setRxEvents(BENCH_RX_EVENTS);
+    Serial.printf("device        %s\n", nfc.deviceName);
+    Serial.printf("baud          %lu\n", (unsigned long)nfc.getBaudRate());
+    Serial.printf("begin_ms      %.2f\n", beginUs / 1000.0f);
+
+    // Time to first UID (tag already on the antenna)
+    t0 = micros();
+    bool found = false;
+    while (!found && micros() - t0 < BENCH_FIRST_MS * 1000UL) {
+        found = nfc.iso14443aGetUID(uid, uidLen, sak);
+    }
+    if (!found) {
+        Serial.println("first_uid_ms  none (no tag?)");
+        return;
+    }
+    Serial.printf("first_uid_ms  %.2f\n", (micros() - t0) / 1000.0f);
+    Serial.printf("uid_len       %u\n", uidLen);
+
+    // Throughput run
+    uid4.clear();
+    uid7.clear();
+    nfc.resetStats();
+    uint32_t reads = 0, fails = 0;
+
+    cpu.start();
+    uint32_t runStart = millis();
+    while (millis() - runStart < BENCH_SECONDS * 1000UL) {
+        t0 = micros();
+        if (!nfc.iso14443aGetUID(uid, uidLen, sak)) {
+            fails++;
+            continue;
+        }
+        uint32_t readUs = micros() - t0;
+        reads++;
+
+        // Last exchange of each phase (for 7-byte UIDs: cascade level 2)
+        CR95HF_Stats st = nfc.getStats();
+        PhaseSamplers& p = (uidLen == 7) ? uid7 : uid4;
+        p.wake.add(st.latencyLastUs[CR95HF_PHASE_WAKE]);
+        p.anticoll.add(st.latencyLastUs[CR95HF_PHASE_ANTICOLL]);
+        p.select.add(st.latencyLastUs[CR95HF_PHASE_SELECT]);
+        p.total.add(readUs);
+    }
+    uint32_t runMs = millis() - runStart;
+    float busy = cpu.stop();
+
+    CR95HF_Stats st = nfc.getStats();
+    Serial.printf("uids_per_s    %.1f\n", reads * 1000.0f / runMs);
+    Serial.printf("reads         %lu\n", (unsigned long)reads);
+    Serial.printf("failed        %lu\n", (unsigned long)fails);
+    Serial.printf("rx_timeouts   %lu\n", (unsigned long)(st.rxTimeoutCode + st.rxTimeoutLen +
+                                                        st.rxTimeoutPayload));
+    Serial.printf("cpu_busy_pct  %.1f\n", busy * 100);
+    printPhases("latency 4-byte UID:", uid4);
+    printPhases("latency 7-byte UID:", uid7);
+}
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);  // Wait for serial monitor
+
+    // Calibrate CPU load probe on the loop() core before any NFC traffic
+    if (cpu.begin()) cpu.calibrate(500);
+
+    runBenchmark();
+    Serial.println();
+    Serial.println("Send any character to run again.");
+}
+
+// ============================================================================
+// Main Loop
+// ============================================================================
+
+void loop() {
+    if (Serial.available()) {
+        while (Serial.available()) Serial.read();
+        runBenchmark();
+        Serial.println();
+        Serial.println("Send any character to run again.");
+    }
+    delay(50);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file    Footprint.ino
+ * @brief   CR95HF build configuration and memory footprint report
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ *
+ * Prints the CR95HF_FEATURE_* switches and buffer sizes this sketch was
+ * built with, the RAM taken by a driver object and the sketch flash size.
+ * Build it once per configuration and compare the reports, e.g.:
+ *
+ *   arduino-cli compile -b esp32:esp32:esp32c6 --build-property \
+ *     "compiler.cpp.extra_flags=-DCR95HF_FEATURE_DEBUG=0 -DCR95HF_FEATURE_NAMES=0"
+ *
+ * or, with PlatformIO:
+ *
+ *   build_flags = -DCR95HF_FEATURE_DIAGNOSTICS=0 -DCR95HF_RF_BUFFER=64
+ *
+ * The flags must reach the library sources, so a #define in this sketch
+ * is not enough.
+ *
+ * No reader needs to be connected.
+ */
+
+#include <CR95HF.h>
+#include <CR95HFPoller.h>
+
+// ============================================================================
+// Configuration - Adjust for your hardware
+// ============================================================================
+
+#define NFC_RX_PIN  1       // RX pin (from CR95HF TXD)
+#define NFC_TX_PIN  2       // TX pin (to CR95HF RXD)
+#define NFC_BAUD    57600   // CR95HF baud rate (fixed)
+
+// ============================================================================
+// Report
+// ============================================================================
+
+static void feature(const char* name, int enabled) {
+    Serial.printf("  %-28s %s\n", name, enabled ? "on" : "off");
+}
+
+static void size(const char* name, unsigned long bytes) {
+    Serial.printf("  %-28s %6lu bytes\n", name, bytes);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);  // Wait for serial monitor
+
+    Serial.println();
+    Serial.println("=== CR95HF Footprint ===");
+
+    Serial.println("Features:");
+    feature("CR95HF_FEATURE_DEBUG", CR95HF_FEATURE_DEBUG);
+    feature("CR95HF_FEATURE_DIAGNOSTICS", CR95HF_FEATURE_DIAGNOSTICS);
+    feature("CR95HF_FEATURE_NAMES", CR95HF_FEATURE_NAMES);
+    feature("CR95HF_FEATURE_ISO15693", CR95HF_FEATURE_ISO15693);
+    feature("CR95HF_FEATURE_ISO14443B", CR95HF_FEATURE_ISO14443B);
+    feature("CR95HF_FEATURE_FELICA", CR95HF_FEATURE_FELICA);
+
+    Serial.println("Buffers:");
+    size("CR95HF_RF_BUFFER", CR95HF_RF_BUFFER);
+    size("CR95HF_TX_BUFFER", CR95HF_TX_BUFFER);
+#if CR95HF_FEATURE_DEBUG
+    size("CR95HF_LOG_SIZE", CR95HF_LOG_SIZE);
+#endif
+    size("NTAG page cache", sizeof(CR95HF_PageCache) * CR95HF_NTAG_CACHE_TAGS);
+
+    Serial.println("Objects:");
+    size("CR95HF", sizeof(CR95HF));
+    size("CR95HFPoller", sizeof(CR95HFPoller));
+
+    // Heap actually taken by one driver, including allocator overhead
+    uint32_t before = ESP.getFreeHeap();
+    CR95HF* nfc = new CR95HF(Serial1, NFC_RX_PIN, NFC_TX_PIN, NFC_BAUD);
+    size("CR95HF on the heap", before - ESP.getFreeHeap());
+    delete nfc;
+
+    Serial.println("Sketch:");
+    size("Flash (whole sketch)", ESP.getSketchSize());
+    Serial.println("========================");
+}
+
+void loop() {
+    delay(1000);
+}
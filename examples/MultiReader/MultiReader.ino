@@ -0,0 +1,78 @@
+/**
+ * @file    MultiReader.ino
+ * @brief   Two CR95HF readers polled side by side with CR95HFGroup
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ *
+ * Each sweep sends every command to both readers before waiting for
+ * answers, so polling two readers takes about as long as polling one.
+ * Prints the UID seen by each reader and the sweep time.
+ *
+ * Hardware Setup (ESP32 / ESP32-S3, two free UARTs):
+ * - Reader 0: GPIO16 = RX (CR95HF TXD), GPIO17 = TX (CR95HF RXD) on Serial1
+ * - Reader 1: GPIO18 = RX (CR95HF TXD), GPIO19 = TX (CR95HF RXD) on Serial2
+ * - CR95HF SSI_0 and SSI_1 tied to GND (UART mode) on both modules
+ *
+ * @note Adjust pin definitions for your hardware
+ */
+
+#include <CR95HF.h>
+#include <CR95HFGroup.h>
+
+// ============================================================================
+// Configuration - Adjust for your hardware
+// ============================================================================
+
+#define NFC0_RX_PIN     16      // Reader 0 RX pin (from CR95HF TXD)
+#define NFC0_TX_PIN     17      // Reader 0 TX pin (to CR95HF RXD)
+#define NFC1_RX_PIN     18      // Reader 1 RX pin (from CR95HF TXD)
+#define NFC1_TX_PIN     19      // Reader 1 TX pin (to CR95HF RXD)
+#define NFC_BAUD        57600   // CR95HF baud rate
+
+CR95HF nfc0(Serial1, NFC0_RX_PIN, NFC0_TX_PIN, NFC_BAUD);
+CR95HF nfc1(Serial2, NFC1_RX_PIN, NFC1_TX_PIN, NFC_BAUD);
+CR95HFGroup readers;
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);  // Wait for serial monitor
+
+    Serial.println();
+    Serial.println("=== CR95HF Multi-Reader Example ===");
+
+    CR95HF* all[] = {&nfc0, &nfc1};
+    for (uint8_t i = 0; i < 2; i++) {
+        if (all[i]->begin(false)) {
+            readers.add(*all[i]);
+            Serial.printf("Reader %u: %s\n", i, all[i]->deviceName);
+        } else {
+            Serial.printf("Reader %u: init FAILED - check wiring\n", i);
+        }
+    }
+}
+
+// ============================================================================
+// Main Loop
+// ============================================================================
+
+void loop() {
+    CR95HF_GroupResult res[CR95HF_GROUP_MAX];
+
+    if (readers.readAll(res) > 0) {
+        for (uint8_t i = 0; i < readers.size(); i++) {
+            if (res[i].status != CR95HF_ASYNC_DONE) continue;
+            Serial.printf("Reader %u UID: ", i);
+            for (uint8_t j = 0; j < res[i].uid.uidLen; j++) {
+                Serial.printf("%02X", res[i].uid.uid[j]);
+            }
+            Serial.printf("  (%s)\n", readers.reader(i).getCardType(res[i].uid.sak));
+        }
+        Serial.printf("Sweep: %lu us\n", (unsigned long)readers.lastSweepUs());
+    }
+
+    delay(100);
+}
@@ -0,0 +1,216 @@
+/**
+ * @file    Arduino.cpp
+ * @brief   Host Arduino / FreeRTOS shim implementation
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#include "Arduino.h"
+#include <stdarg.h>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Time
+// ============================================================================
+
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+unsigned long micros() {
+    return (unsigned long)(uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - bootTime).count();
+}
+
+unsigned long millis() {
+    return (unsigned long)(uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - bootTime).count();
+}
+
+void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+// ============================================================================
+// GPIO (nothing connected)
+// ============================================================================
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return HIGH; }
+void attachInterruptArg(uint8_t, void (*)(void*), void*, int) {}
+void detachInterrupt(uint8_t) {}
+
+// ============================================================================
+// Print / HardwareSerial
+// ============================================================================
+
+size_t Print::write(const uint8_t* buf, size_t len) {
+    size_t n = 0;
+    while (len--) n += write(*buf++);
+    return n;
+}
+
+size_t Print::printf(const char* fmt, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (len <= 0) return 0;
+    if ((size_t)len >= sizeof(buf)) len = sizeof(buf) - 1;
+    return write((const uint8_t*)buf, len);
+}
+
+size_t Print::print(unsigned long n, int base) {
+    char buf[8 * sizeof(long) + 1];
+    char* p = &buf[sizeof(buf) - 1];
+    *p = '\0';
+    if (base < 2) base = DEC;
+    do {
+        unsigned d = n % base;
+        *--p = d < 10 ? '0' + d : 'A' + d - 10;
+        n /= base;
+    } while (n);
+    return print(p);
+}
+
+size_t Print::print(long n, int base) {
+    if (n < 0 && base == DEC) return print('-') + print((unsigned long)-n, base);
+    return print((unsigned long)n, base);
+}
+
+size_t Print::print(double n, int digits) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return print(buf);
+}
+
+void HardwareSerial::begin(unsigned long baud, uint32_t, int8_t, int8_t, bool, unsigned long, uint8_t) {
+    _baud = baud;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return _out ? fwrite(&c, 1, 1, _out) : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t len) {
+    return _out ? fwrite(buf, 1, len, _out) : len;
+}
+
+HardwareSerial Serial(stdout);
+HardwareSerial Serial1;
+HardwareSerial Serial2;
+EspClass ESP;
+
+// ============================================================================
+// FreeRTOS
+// ============================================================================
+
+/// Binary semaphore state behind a StaticSemaphore_t
+struct HostSemaphore {
+    std::mutex lock;
+    std::condition_variable cv;
+    bool given = false;
+};
+
+BaseType_t xPortGetCoreID() {
+    return 0;
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)millis();
+}
+
+/// Handle of the task running on this thread (NULL outside tasks)
+static thread_local TaskHandle_t currentTask = NULL;
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return currentTask;
+}
+
+/// Identity of a host task (its thread runs detached)
+struct HostTask {};
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char*, uint32_t, void* arg,
+                                   UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+    HostTask* task = new HostTask;
+    if (handle) *handle = task;
+    std::thread([=] {
+        currentTask = task;
+        fn(arg);
+    }).detach();
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    // A task deleting itself returns from its function right after; a
+    // thread cannot be stopped from outside
+    if (task == NULL || task == currentTask) {
+        delete (HostTask*)currentTask;
+        currentTask = NULL;
+    }
+}
+
+void vTaskDelay(TickType_t ticks) {
+    delay(ticks);
+}
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t increment) {
+    *previousWake += increment;
+    int32_t wait = (int32_t)(*previousWake - xTaskGetTickCount());
+    if (wait > 0) delay(wait);
+}
+
+/// Every semaphore created, freed at exit (static ones are never deleted)
+static std::mutex semaphoresLock;
+static std::vector<std::unique_ptr<HostSemaphore>> semaphores;
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t* buffer) {
+    std::lock_guard<std::mutex> guard(semaphoresLock);
+    semaphores.emplace_back(new HostSemaphore);
+    buffer->impl = semaphores.back().get();
+    return buffer->impl;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+    HostSemaphore* s = (HostSemaphore*)sem;
+    std::unique_lock<std::mutex> guard(s->lock);
+    if (ticks == portMAX_DELAY) {
+        s->cv.wait(guard, [s] { return s->given; });
+    } else if (!s->cv.wait_for(guard, std::chrono::milliseconds(ticks), [s] { return s->given; })) {
+        return pdFALSE;
+    }
+    s->given = false;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    HostSemaphore* s = (HostSemaphore*)sem;
+    {
+        std::lock_guard<std::mutex> guard(s->lock);
+        if (s->given) return pdFALSE;
+        s->given = true;
+        s->cv.notify_one();     // Under the lock: the waiter may free the owner next
+    }
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t* woken) {
+    if (woken) *woken = pdFALSE;
+    return xSemaphoreGive(sem);
+}
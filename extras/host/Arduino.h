@@ -0,0 +1,185 @@
+/**
+ * @file    Arduino.h
+ * @brief   Minimal Arduino-ESP32 core for building the CR95HF driver on a host
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * Just enough of the Arduino core and of FreeRTOS for the library sources and
+ * CR95HF_SimTransport to build and run on Linux / macOS:
+ * - millis() / micros() / delay() on the host steady clock
+ * - Print (printf to stdout), Stream, HardwareSerial with no port behind it
+ * - FreeRTOS tasks on std::thread, binary semaphores, 1 ms ticks; a task
+ *   can only delete itself (CR95HF_CpuLoad does not stop on the host)
+ *
+ * The real ESP32 core pulls FreeRTOS in through Arduino.h as well, which is
+ * why the library only includes the FreeRTOS headers on ARDUINO_ARCH_ESP32.
+ * CR95HF_SpiTransport is not available here.
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <functional>
+
+// ============================================================================
+// Arduino Core
+// ============================================================================
+
+#define HEX 16
+#define DEC 10
+
+#define LOW     0
+#define HIGH    1
+#define INPUT   0x01
+#define OUTPUT  0x03
+#define INPUT_PULLUP 0x05
+#define RISING  0x01
+#define FALLING 0x02
+
+#define SERIAL_8N2  0x800003c
+
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void attachInterruptArg(uint8_t pin, void (*isr)(void*), void* arg, int mode);
+void detachInterrupt(uint8_t pin);
+
+using std::min;
+using std::max;
+
+/**
+ * @brief Text output, formatted to stdout by HardwareSerial
+ */
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t len);
+
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+    size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+    size_t print(int n, int base = DEC) { return print((long)n, base); }
+    size_t print(unsigned char n, int base = DEC) { return print((unsigned long)n, base); }
+    size_t print(double n, int digits = 2);
+    size_t println() { return print("\r\n"); }
+    template<typename T> size_t println(T v) { return print(v) + println(); }
+    template<typename T> size_t println(T v, int f) { return print(v, f) + println(); }
+};
+
+/**
+ * @brief Byte input on top of Print
+ */
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+typedef std::function<void(void)> OnReceiveCb;
+
+/**
+ * @brief Serial port with nothing connected; output goes to stdout
+ */
+class HardwareSerial : public Stream {
+public:
+    explicit HardwareSerial(FILE* out = NULL) : _out(out), _baud(0) {}
+
+    void begin(unsigned long baud, uint32_t config = 0, int8_t rxPin = -1, int8_t txPin = -1,
+               bool invert = false, unsigned long timeoutMs = 20000UL, uint8_t rxfifoFull = 112);
+    void end() {}
+    void updateBaudRate(unsigned long baud) { _baud = baud; }
+    unsigned long baudRate() { return _baud; }
+    void flush() { if (_out) fflush(_out); }
+    void onReceive(OnReceiveCb cb, bool onlyOnTimeout = false) { (void)cb; (void)onlyOnTimeout; }
+    bool setRxTimeout(uint8_t symbols) { (void)symbols; return true; }
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t len) override;
+    using Print::write;
+
+    operator bool() const { return true; }
+
+private:
+    FILE* _out;
+    unsigned long _baud;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+/**
+ * @brief Chip information (no heap accounting on the host)
+ */
+class EspClass {
+public:
+    uint32_t getFreeHeap() { return 0; }
+    uint32_t getSketchSize() { return 0; }
+};
+
+extern EspClass ESP;
+
+// ============================================================================
+// FreeRTOS
+// ============================================================================
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef void (*TaskFunction_t)(void*);
+typedef void* TaskHandle_t;
+typedef void* SemaphoreHandle_t;
+
+/// Storage for a static semaphore (the host keeps the state elsewhere)
+typedef struct { void* impl; } StaticSemaphore_t;
+
+#define pdTRUE              1
+#define pdFALSE             0
+#define pdPASS              pdTRUE
+#define portMAX_DELAY       0xFFFFFFFFUL
+#define portTICK_PERIOD_MS  1
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
+#define tskNO_AFFINITY      0x7FFFFFFF
+#define configMAX_PRIORITIES 25
+#define tskIDLE_PRIORITY    0
+
+BaseType_t xPortGetCoreID();
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackDepth,
+                                   void* arg, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t increment);
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t* buffer);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t* woken);
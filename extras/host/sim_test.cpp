@@ -0,0 +1,657 @@
+/**
+ * @file    sim_test.cpp
+ * @brief   Host tests: CR95HF driver against CR95HF_SimTransport
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * Build and run with `make -C extras/host`. Exits non-zero on failure.
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#include <CR95HF.h>
+#include <CR95HFGroup.h>
+#include <CR95HF_SimTransport.h>
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+static const uint8_t UID4[]  = {0xDE, 0xAD, 0xBE, 0xEF};
+static const uint8_t UID4B[] = {0xDE, 0xAD, 0x3E, 0x01};
+static const uint8_t UID7[]  = {0x04, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+static const uint8_t UID10[] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA};
+
+static bool hasUid(const CR95HF_UIDResult* tags, uint8_t n, const uint8_t* uid, uint8_t len) {
+    for (uint8_t i = 0; i < n; i++) {
+        if (tags[i].uidLen == len && memcmp(tags[i].uid, uid, len) == 0) return true;
+    }
+    return false;
+}
+
+static CR95HF_AsyncStatus pollDone(CR95HF& nfc, CR95HF_UIDResult& r, uint32_t maxMs = 1000) {
+    CR95HF_AsyncStatus st = CR95HF_ASYNC_BUSY;
+    uint32_t start = millis();
+    while (st == CR95HF_ASYNC_BUSY && millis() - start < maxMs) st = nfc.poll(r);
+    return st;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+static void testBegin() {
+    CR95HF_SimTransport sim;
+    CR95HF nfc(sim);
+    CHECK(nfc.begin());
+#if CR95HF_FEATURE_DIAGNOSTICS
+    CHECK(strcmp(nfc.deviceName, CR95HF_SIM_IDN) == 0);
+#endif
+}
+
+static void testUartConstructor() {
+    // Built-in transport on a port with nothing behind it
+    CR95HF* nfc = new CR95HF(Serial1, 1, 2, 57600);
+    CHECK(nfc->getBaudRate() == 57600);
+    delete nfc;
+}
+
+static void testUidLengths() {
+    const uint8_t* uids[] = {UID4, UID7, UID10};
+    const uint8_t lens[] = {4, 7, 10};
+
+    for (uint8_t i = 0; i < 3; i++) {
+        CR95HF_SimTransport sim;
+        CR95HF nfc(sim);
+        CHECK(nfc.begin());
+
+        uint8_t uid[10], uidLen, sak;
+        CHECK(!nfc.iso14443aGetUID(uid, uidLen, sak));
+
+        sim.addTag(uids[i], lens[i], SAK_MIFARE_UL, 0x0044);
+        CHECK(nfc.iso14443aGetUID(uid, uidLen, sak));
+        CHECK(uidLen == lens[i] && memcmp(uid, uids[i], lens[i]) == 0);
+        CHECK(sak == SAK_MIFARE_UL);
+        CHECK(nfc.isStillPresent(uids[i], lens[i]));
+        CHECK(sim.flagErrors() == 0);
+    }
+}
+
+static void testAsyncRead() {
+    CR95HF_SimTransport sim;
+    CR95HF nfc(sim);
+    CHECK(nfc.begin());
+    sim.addTag(UID7, sizeof(UID7), SAK_MIFARE_UL, 0x0044);
+
+    CR95HF_UIDResult r;
+    CHECK(nfc.startGetUID());
+    CHECK(pollDone(nfc, r) == CR95HF_ASYNC_DONE);
+    CHECK(r.uidLen == 7 && memcmp(r.uid, UID7, 7) == 0);
+}
+
+/// poll() until done; false if a call sent a command and waited for it
+static bool pollStepwise(CR95HF& nfc, CR95HF_SimTransport& sim, CR95HF_AsyncStatus& st,
+                         CR95HF_UIDResult& r) {
+    bool stepwise = true;
+    st = CR95HF_ASYNC_BUSY;
+    uint32_t start = millis();
+    while (st == CR95HF_ASYNC_BUSY && millis() - start < 1000) {
+        uint32_t sent = sim.commandCount();
+        st = nfc.poll(r);
+        // A call sends at most the next command; the final one sends nothing
+        uint32_t n = sim.commandCount() - sent;
+        if (n > 1 || (n && st != CR95HF_ASYNC_BUSY)) stepwise = false;
+    }
+    return stepwise;
+}
+
+static void testAsyncNoBlock() {
+    CR95HF_SimTransport sim;
+    CR95HF nfc(sim);
+    CHECK(nfc.begin());
+    nfc.setFieldDutyCycle(true, 0);
+    CHECK(nfc.fieldOff());
+    CHECK(nfc.setArcB(0x23));       // Written after the next ProtocolSelect
+
+    // Answers take 3 ms, so a call cannot send a command and see its reply
+    // without waiting for it
+    sim.setLatency(3000, 191);
+
+    // Field off: ProtocolSelect, ARC_B, WUPA, then PROTO_OFF for the empty field
+    CR95HF_UIDResult r;
+    CR95HF_AsyncStatus st;
+    uint32_t before = sim.commandCount();
+    CHECK(nfc.startGetUID());
+    CHECK(sim.commandCount() - before == 1);
+    CHECK(pollStepwise(nfc, sim, st, r));
+    CHECK(st == CR95HF_ASYNC_NO_TAG);
+    CHECK(sim.commandCount() - before == 4);
+    CHECK(sim.lastCommand()[0] == CR95HF_CMD_PROTOCOL && sim.lastCommand()[2] == CR95HF_PROTO_OFF);
+    CHECK(!nfc.busy());
+
+    sim.addTag(UID7, sizeof(UID7), SAK_MIFARE_UL, 0x0044);
+    before = sim.commandCount();
+    CHECK(nfc.startGetUID());
+    CHECK(sim.commandCount() - before == 1);
+    CHECK(pollStepwise(nfc, sim, st, r));
+    CHECK(st == CR95HF_ASYNC_DONE);
+    CHECK(r.uidLen == 7 && memcmp(r.uid, UID7, 7) == 0);
+    CHECK(sim.arcB() == 0x23);
+}
+
+static void testAsyncWarmCheck() {
+    CR95HF_SimTransport sim;
+    CR95HF_WarmState state;
+    {
+        CR95HF nfc(sim);
+        CHECK(nfc.begin());
+        nfc.saveWarmState(state);
+    }
+
+    // beginFast() skips the IDN; the first empty poll() runs it, then PROTO_OFF
+    CR95HF nfc(sim);
+    CHECK(nfc.beginFast(state));
+    CHECK(nfc.warmCheckPending());
+    nfc.setFieldDutyCycle(true, 0);
+    sim.setLatency(3000, 191);
+
+    CR95HF_UIDResult r;
+    CR95HF_AsyncStatus st;
+    uint32_t before = sim.commandCount();
+    CHECK(nfc.startGetUID());
+    CHECK(pollStepwise(nfc, sim, st, r));
+    CHECK(st == CR95HF_ASYNC_NO_TAG);
+    CHECK(!nfc.warmCheckPending());
+    CHECK(sim.commandCount() - before == 3);   // WUPA, IDN, PROTO_OFF
+    CHECK(sim.lastCommand()[0] == CR95HF_CMD_PROTOCOL && sim.lastCommand()[2] == CR95HF_PROTO_OFF);
+#if CR95HF_FEATURE_DIAGNOSTICS
+    CHECK(strcmp(nfc.deviceName, CR95HF_SIM_IDN) == 0);
+#endif
+}
+
+static void testGroupOverlap() {
+    CR95HF_SimTransport sim0, sim1;
+    CR95HF nfc0(sim0), nfc1(sim1);
+    CHECK(nfc0.begin() && nfc1.begin());
+    sim0.addTag(UID4, sizeof(UID4), SAK_MIFARE_1K, 0x0004);
+    sim1.addTag(UID7, sizeof(UID7), SAK_MIFARE_UL, 0x0044);
+    sim0.setLatency(3000, 0);
+    sim1.setLatency(3000, 0);
+
+    // Field off first, so the sweep includes the ProtocolSelect
+    uint8_t uid[10], uidLen, sak;
+    CHECK(nfc0.fieldOff() && nfc1.fieldOff());
+    uint32_t t = micros();
+    CHECK(nfc0.iso14443aGetUID(uid, uidLen, sak) && nfc1.iso14443aGetUID(uid, uidLen, sak));
+    uint32_t sequentialUs = micros() - t;
+
+    CHECK(nfc0.fieldOff() && nfc1.fieldOff());
+    CR95HFGroup group;
+    CHECK(group.add(nfc0) == 0 && group.add(nfc1) == 1);
+
+    // Both first frames go out before either reply is waited for
+    uint32_t sent0 = sim0.commandCount(), sent1 = sim1.commandCount();
+    CHECK(group.start());
+    CHECK(sim0.commandCount() - sent0 == 1 && sim1.commandCount() - sent1 == 1);
+    group.cancel();
+
+    CHECK(nfc0.fieldOff() && nfc1.fieldOff());
+    CR95HF_GroupResult res[CR95HF_GROUP_MAX];
+    CHECK(group.readAll(res) == 2);
+    CHECK(res[0].uid.uidLen == 4 && res[1].uid.uidLen == 7);
+    CHECK(group.lastSweepUs() * 4 < sequentialUs * 3);
+}
+
+static void testInventory() {
+    CR95HF_SimTransport sim;
+    CR95HF nfc(sim);
+    CHECK(nfc.begin());
+
+    // UID4 and UID4B first differ inside a byte: bit-oriented anticollision
+    sim.addTag(UID4, sizeof(UID4), SAK_MIFARE_1K, 0x0004);
+    sim.addTag(UID4B, sizeof(UID4B), SAK_MIFARE_1K, 0x0004);
+    sim.addTag(UID7, sizeof(UID7), SAK_MIFARE_UL, 0x0044);
+
+    CR95HF_UIDResult tags[4];
+    uint8_t n = nfc.inventory(tags, 4);
+    CHECK(n == 3);
+    CHECK(hasUid(tags, n, UID4, sizeof(UID4)));
+    CHECK(hasUid(tags, n, UID4B, sizeof(UID4B)));
+    CHECK(hasUid(tags, n, UID7, sizeof(UID7)));
+    CHECK(sim.flagErrors() == 0);
+}
+
+static void testFaults() {
+    CR95HF_SimTransport sim;
+    CR95HF nfc(sim);
+    CHECK(nfc.begin());
+    sim.addTag(UID4, sizeof(UID4), SAK_MIFARE_1K, 0x0004);
+
+    // A garbled or missing WUPA answer falls back to REQA
+    uint8_t uid[10], uidLen, sak;
+    sim.injectResponse(CR95HF_RSP_FRAMEERR);
+    CHECK(nfc.iso14443aGetUID(uid, uidLen, sak));
+    sim.dropResponses(1);
+    CHECK(nfc.iso14443aGetUID(uid, uidLen, sak));
+#if CR95HF_FEATURE_DIAGNOSTICS
+    CHECK(nfc.getStats().rspFrameErr == 1);
+    CHECK(nfc.getStats().rxTimeoutCode == 1);
+#endif
+
+    // ATQA, then CL1: flip a UID bit so the BCC no longer matches
+    nfc.halt();
+    sim.corruptAnswer(1, 0, 0x01);
+    CHECK(!nfc.iso14443aGetUID(uid, uidLen, sak));
+#if CR95HF_FEATURE_DIAGNOSTICS
+    CHECK(nfc.getStats().rxBccError == 1);
+#endif
+    CHECK(nfc.iso14443aGetUID(uid, uidLen, sak));
+}
+
+static void testTrackDebounce() {
+    CR95HF_SimTransport sim;
+    CR95HF nfc(sim);
+    CHECK(nfc.begin());
+    int t = sim.addTag(UID4, sizeof(UID4), SAK_MIFARE_1K, 0x0004);
+
+    uint8_t enters = 0, leaves = 0;
+    nfc.onTagEnter([&](const CR95HF_UIDResult&) { enters++; });
+    nfc.onTagLeave([&](const CR95HF_UIDResult&) { leaves++; });
+    nfc.setTrackingWindow(200, 2);
+
+    CHECK(nfc.track() == 1);
+    CHECK(enters == 1);
+
+    // Three misses inside the hold-off: still tracked
+    sim.removeTag(t);
+    for (uint8_t i = 0; i < 3; i++) nfc.track();
+    CHECK(leaves == 0 && nfc.trackedCount() == 1);
+
+    // Back within the hold-off: no second enter event
+    sim.restoreTag(t);
+    CHECK(nfc.track() == 1);
+    CHECK(enters == 1 && leaves == 0);
+
+    // Hold-off over: the leave waits for the third miss
+    sim.removeTag(t);
+    delay(210);
+    nfc.track();
+    nfc.track();
+    CHECK(leaves == 0);
+    CHECK(nfc.track() == 0);
+    CHECK(leaves == 1 && nfc.trackedCount() == 0);
+}
+
+static void testAutoTune() {
+    CR95HF_SimTransport sim;
+    CR95HF nfc(sim);
+    CHECK(nfc.begin());
+    sim.addTag(UID4, sizeof(UID4), SAK_MIFARE_1K, 0x0004);
+
+    // Marginal antenna: 0x53 always reads, 0x52 half the time, nothing else
+    sim.setAnalogModel([](uint8_t arcB) -> uint8_t {
+        return arcB == 0x53 ? 0 : arcB == 0x52 ? 50 : 100;
+    });
+
+    uint8_t arcB = 0;
+    CHECK(nfc.autoTuneAnalog(arcB, 4));
+    CHECK(arcB == 0x53);
+    CHECK(sim.arcB() == 0x53);
+
+    // The setting stays in use
+    uint8_t uid[10], uidLen, sak;
+    CHECK(nfc.iso14443aGetUID(uid, uidLen, sak));
+}
+
+/// NTAG216-like memory behind READ / FAST_READ
+struct NtagModel {
+    uint8_t mem[45 * 4];
+    bool fastRead = true;
+    uint16_t reads = 0;
+    uint16_t fastReads = 0;
+
+    void attach(CR95HF_SimTransport& sim) {
+        for (uint16_t i = 0; i < sizeof(mem); i++) mem[i] = (uint8_t)i;
+        sim.onRfCommand([this](uint8_t, const uint8_t* rf, uint8_t len, uint8_t* resp, uint8_t& respLen) {
+            if (rf[0] == NTAG_CMD_READ && len == 2) {
+                reads++;
+                for (uint8_t i = 0; i < 16; i++) resp[i] = mem[(rf[1] * 4 + i) % sizeof(mem)];
+                respLen = 16;
+                return true;
+            }
+            if (rf[0] == NTAG_CMD_FAST_READ && len == 3 && fastRead) {
+                uint16_t n = (rf[2] - rf[1] + 1) * 4;
+                if (rf[2] >= 45 || n > respLen) return false;
+                fastReads++;
+                memcpy(resp, &mem[rf[1] * 4], n);
+                respLen = n;
+                return true;
+            }
+            return false;
+        });
+    }
+};
+
+static void testNtagTiming() {
+    CR95HF_SimTransport sim;
+    CR95HF nfc(sim);
+    NtagModel tag;
+    tag.attach(sim);
+    sim.addTag(UID7, sizeof(UID7), SAK_MIFARE_UL, 0x0044);
+    CHECK(nfc.begin());
+
+    // 57600 baud 8N2 and RF air time: the largest FAST_READ takes ~38 ms
+    sim.setLatency(100, 191);
+    sim.setAirTime(true);
+
+    uint8_t uid[10], uidLen, sak;
+    CHECK(nfc.iso14443aGetUID(uid, uidLen, sak));
+    uint8_t pages[40 * 4];
+    CHECK(nfc.ntagReadPages(0, 40, pages));
+    CHECK(memcmp(pages, tag.mem, sizeof(pages)) == 0);
+    CHECK(tag.fastReads == 2 && tag.reads == 0);
+
+    // A lost reply: that chunk (4 pages) is READ, the rest still FAST_READ
+    nfc.ntagClearCache();
+    sim.dropResponses(1);
+    CHECK(nfc.ntagReadPages(0, 8, pages));
+    CHECK(memcmp(pages, tag.mem, 8 * 4) == 0);
+    CHECK(tag.reads == 1 && tag.fastReads == 4);
+    nfc.ntagClearCache();
+    CHECK(nfc.ntagReadPages(0, 8, pages));
+    CHECK(tag.reads == 1 && tag.fastReads == 5);
+}
+
+/// ISO-DEP card: RATS, chaining both ways, S(WTX); answers the APDU reversed
+struct IsoDepCard {
+    CR95HF_SimTransport* sim = nullptr;
+    uint8_t cmd[64];
+    uint8_t cmdLen = 0;
+    uint8_t rsp[64];
+    uint8_t rspLen = 0;
+    uint8_t rspPos = 0;
+    uint8_t last[24];               // Last block sent, for retransmission
+    uint8_t lastLen = 0;
+    uint8_t num = 1;                // Block number of the last block sent
+    bool wtx = false;               // Ask for more time before the answer
+    bool repeatOnce = false;        // Answer the next R(ACK) with the old block
+    uint8_t dropFrame = 0;          // Lose the reply with this frame count (0 = none)
+    uint8_t frames = 0;             // Blocks sent
+    uint8_t cmdBlocks = 0;          // I-blocks received
+    uint8_t naks = 0;               // R(NAK) received
+    uint8_t wtxm = 0;               // Multiplier the reader confirmed
+
+    bool send(const uint8_t* f, uint8_t n, uint8_t* resp, uint8_t& respLen) {
+        if (f != last) memcpy(last, f, n);
+        lastLen = n;
+        memcpy(resp, f, n);
+        respLen = n;
+        if (++frames == dropFrame) sim->dropResponses(1);
+        return true;
+    }
+
+    bool sendNext(uint8_t* resp, uint8_t& respLen) {
+        uint8_t n = (rspLen - rspPos < 20) ? rspLen - rspPos : 20;
+        uint8_t f[21];
+        f[0] = ISO14443_4_PCB_I | num | ((rspPos + n < rspLen) ? ISO14443_4_PCB_CHAIN : 0);
+        memcpy(&f[1], &rsp[rspPos], n);
+        rspPos += n;
+        return send(f, n + 1, resp, respLen);
+    }
+
+    void attach(CR95HF_SimTransport& s) {
+        sim = &s;
+        s.onRfCommand([this](uint8_t, const uint8_t* rf, uint8_t len, uint8_t* resp, uint8_t& respLen) {
+            uint8_t pcb = rf[0];
+            if (pcb == ISO14443_4_RATS) {
+                static const uint8_t ats[] = {0x02, 0x00};  // FSC 16, FWI 4
+                num = 1;
+                return send(ats, sizeof(ats), resp, respLen);
+            }
+            if ((pcb & 0xE2) == ISO14443_4_PCB_I) {
+                num = pcb & 0x01;
+                cmdBlocks++;
+                memcpy(&cmd[cmdLen], &rf[1], len - 1);
+                cmdLen += len - 1;
+                if (pcb & ISO14443_4_PCB_CHAIN) {
+                    uint8_t ack = ISO14443_4_PCB_R_ACK | num;
+                    return send(&ack, 1, resp, respLen);
+                }
+                for (uint8_t i = 0; i < cmdLen; i++) rsp[i] = cmd[cmdLen - 1 - i];
+                rspLen = cmdLen;
+                rspPos = 0;
+                cmdLen = 0;
+                if (wtx) {
+                    wtx = false;
+                    uint8_t req[2] = {ISO14443_4_PCB_WTX, 0x02};
+                    return send(req, sizeof(req), resp, respLen);
+                }
+                return sendNext(resp, respLen);
+            }
+            if (pcb == ISO14443_4_PCB_WTX && len == 2) {
+                wtxm = rf[1];
+                return sendNext(resp, respLen);
+            }
+            if ((pcb & 0xF6) == ISO14443_4_PCB_R_ACK) {
+                if ((pcb & 0x01) == num || repeatOnce) {
+                    repeatOnce = false;
+                    return send(last, lastLen, resp, respLen);
+                }
+                num = pcb & 0x01;
+                return sendNext(resp, respLen);
+            }
+            if ((pcb & 0xF6) == ISO14443_4_PCB_R_NAK) {
+                naks++;
+                if ((pcb & 0x01) == num) return send(last, lastLen, resp, respLen);
+                uint8_t ack = ISO14443_4_PCB_R_ACK | num;
+                return send(&ack, 1, resp, respLen);
+            }
+            return false;
+        });
+    }
+};
+
+static void testIsoDep() {
+    CR95HF_SimTransport sim;
+    CR95HF nfc(sim);
+    IsoDepCard card;
+    card.attach(sim);
+    sim.addTag(UID7, sizeof(UID7), SAK_MIFARE_PLUS, 0x0344);
+    CHECK(nfc.begin());
+
+    uint8_t uid[10], uidLen, sak;
+    CHECK(nfc.iso14443aGetUID(uid, uidLen, sak));
+    CR95HF_ATS ats;
+    CHECK(nfc.isoDepActivate(&ats, false));
+    CHECK(ats.fsc == 16);
+
+    // 45 bytes against FSC 16: four chained I-blocks out, three back
+    uint8_t apdu[45], resp[64];
+    for (uint8_t i = 0; i < sizeof(apdu); i++) apdu[i] = i + 1;
+    auto exchange = [&]() {
+        uint16_t respLen = sizeof(resp);
+        if (!nfc.transceiveAPDU(apdu, sizeof(apdu), resp, respLen)) return false;
+        if (respLen != sizeof(apdu)) return false;
+        for (uint8_t i = 0; i < sizeof(apdu); i++) {
+            if (resp[i] != apdu[sizeof(apdu) - 1 - i]) return false;
+        }
+        return true;
+    };
+    CHECK(exchange());
+    CHECK(card.cmdBlocks == 4);
+
+    // R(ACK) of the second command block lost, then S(WTX) before the answer
+    card.frames = 0;
+    card.dropFrame = 2;
+    card.wtx = true;
+    CHECK(exchange());
+    CHECK(card.naks == 1);
+    CHECK(card.wtxm == 2);
+
+    // Second answer block lost: R(NAK), the card sends it again
+    card.frames = 0;
+    card.dropFrame = 5;
+    CHECK(exchange());
+    CHECK(card.naks == 2);
+
+    // A repeated answer block is not appended twice
+    card.dropFrame = 0;
+    card.repeatOnce = true;
+    CHECK(exchange());
+    CHECK(!card.repeatOnce);
+    CHECK(nfc.isoDepActive());
+}
+
+/// Batch sizes seen by a continuous-scan callback
+struct ScanLog {
+    std::atomic<uint32_t> batches{0};
+    uint8_t sizes[16];
+    bool uidOk = true;
+
+    CR95HF_ScanCallback callback() {
+        return [this](const CR95HF_TagEvent* tags, uint8_t count) {
+            uint32_t n = batches.load();
+            if (n < sizeof(sizes)) sizes[n] = count;
+            for (uint8_t i = 0; i < count; i++) {
+                if (tags[i].uidLen != 4 || memcmp(tags[i].uid, UID4, 4) != 0) uidOk = false;
+            }
+            batches.store(n + 1);
+        };
+    }
+
+    bool wait(uint32_t n) {
+        uint32_t start = millis();
+        while (batches.load() < n && millis() - start < 2000) delay(1);
+        return batches.load() >= n;
+    }
+};
+
+static void testContinuousScan() {
+    CR95HF_SimTransport sim;
+    CR95HF nfc(sim);
+    CHECK(nfc.begin());
+    sim.addTag(UID4, sizeof(UID4), SAK_MIFARE_1K, 0x0004);
+
+    // No dedupe, size only: the tag left on the antenna fills each batch
+    CR95HF_ScanConfig cfg;
+    cfg.periodMs = 5;
+    cfg.batchSize = 3;
+    cfg.batchMs = 0;
+    cfg.dedupe = false;
+    {
+        ScanLog log;
+        CHECK(nfc.startContinuousScan(cfg, log.callback()));
+        CHECK(log.wait(2));
+        nfc.stopContinuousScan();
+        CHECK(!nfc.taskRunning());
+        CHECK(nfc.scanBatches() == log.batches.load());
+        CHECK(log.sizes[0] == 3 && log.sizes[1] == 3);
+        CHECK(log.uidOk);
+    }
+
+    // Dedupe: the batch never fills, batchMs delivers it with one record
+    cfg.batchSize = 8;
+    cfg.batchMs = 30;
+    cfg.dedupe = true;
+    {
+        ScanLog log;
+        CHECK(nfc.startContinuousScan(cfg, log.callback()));
+        CHECK(log.wait(2));
+        nfc.stopContinuousScan();
+        CHECK(log.sizes[0] == 1 && log.sizes[1] == 1);
+        CHECK(log.uidOk);
+    }
+
+    // CL1 answer corrupted: the read fails after the ATQA and is retried at once
+    cfg.batchSize = 1;
+    sim.corruptAnswer(1, 0, 0x01);
+    {
+        ScanLog log;
+        CHECK(nfc.startContinuousScan(cfg, log.callback()));
+        CHECK(log.wait(1));
+        nfc.stopContinuousScan();
+        CHECK(nfc.scanRetries() == 1);
+        CHECK(log.uidOk);
+    }
+
+    // The callback stops the scan itself
+    std::atomic<uint32_t> calls{0};
+    CHECK(nfc.startContinuousScan(cfg, [&](const CR95HF_TagEvent*, uint8_t) {
+        calls++;
+        nfc.stopContinuousScan();
+    }));
+    uint32_t start = millis();
+    while (nfc.taskRunning() && millis() - start < 2000) delay(1);
+    CHECK(!nfc.taskRunning());
+    CHECK(calls.load() == 1);
+    CHECK(nfc.startTask(5));
+    nfc.stopTask();
+}
+
+#if CR95HF_FEATURE_ISO15693
+static void testVicinityTiming() {
+    CR95HF_SimTransport sim;
+    CR95HF nfc(sim);
+    static const uint8_t uid[ISO15693_UID_LEN] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xE0};
+    int t = sim.addVicinityTag(uid, 4, 32);
+    CHECK(t >= 0);
+    for (uint8_t i = 0; i < 128; i++) sim.vicinityTag(t).memory[i] = i ^ 0x5A;
+    CHECK(nfc.begin());
+
+    // 26 kbit/s: a 31-block READ MULTIPLE BLOCKS answer is ~40 ms on air
+    sim.setLatency(100, 191);
+    sim.setAirTime(true);
+
+    CR95HF_VicinityTag found[2];
+    CHECK(nfc.iso15693Inventory(found, 2, 1) == 1);
+    CHECK(memcmp(found[0].uid, uid, sizeof(uid)) == 0);
+    uint8_t blocks[32 * 4];
+    CHECK(nfc.iso15693ReadBlocks(uid, 0, 32, blocks));
+    CHECK(memcmp(blocks, sim.vicinityTag(t).memory, sizeof(blocks)) == 0);
+}
+#endif
+
+// ============================================================================
+// Runner
+// ============================================================================
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+static const TestCase tests[] = {
+    {"begin", testBegin},
+    {"uart constructor", testUartConstructor},
+    {"uid lengths", testUidLengths},
+    {"async read", testAsyncRead},
+    {"async no block", testAsyncNoBlock},
+    {"async warm check", testAsyncWarmCheck},
+    {"group overlap", testGroupOverlap},
+    {"inventory", testInventory},
+    {"faults", testFaults},
+    {"track debounce", testTrackDebounce},
+    {"auto tune", testAutoTune},
+    {"ntag timing", testNtagTiming},
+    {"iso-dep", testIsoDep},
+    {"continuous scan", testContinuousScan},
+#if CR95HF_FEATURE_ISO15693
+    {"iso15693 timing", testVicinityTiming},
+#endif
+};
+
+int main() {
+    for (const TestCase& t : tests) {
+        int before = failures;
+        t.fn();
+        printf("%s %s\n", failures == before ? "ok  " : "FAIL", t.name);
+    }
+    printf("%s: %d failure(s)\n", failures ? "FAILED" : "PASSED", failures);
+    return failures ? 1 : 0;
+}
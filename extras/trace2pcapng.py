@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Convert a CR95HF binary frame trace (CR95HF_Trace.h) to pcapng.
+
+Usage: trace2pcapng.py capture.bin capture.pcapng [--epoch SECONDS]
+
+Each trace record becomes one Enhanced Packet Block on a LINKTYPE_USER0
+(147) interface. Packet data is a 4-byte pseudo-header followed by the
+raw frame bytes:
+
+    type (1) | 0 (1) | timeout_ms (2, little-endian) | bytes
+
+type: 1 = TX (host -> CR95HF), 2 = RX (CR95HF -> host), 3 = RX timeout.
+The packet comment carries the same information in text, so the capture
+is readable in Wireshark without a dissector. micros() wrap-around is
+unwrapped; timestamps start at --epoch (default 0).
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"C95T"
+VERSION = 1
+LINKTYPE_USER0 = 147
+TYPES = {1: "TX", 2: "RX", 3: "RX timeout"}
+
+
+def block(block_type, body):
+    body += b"\0" * (-len(body) % 4)
+    total = len(body) + 12
+    return struct.pack("<II", block_type, total) + body + struct.pack("<I", total)
+
+
+def option(code, value):
+    return struct.pack("<HH", code, len(value)) + value + b"\0" * (-len(value) % 4)
+
+
+def records(data):
+    pos = 8
+    while pos + 8 <= len(data):
+        us, rtype, length, timeout = struct.unpack_from("<IBBH", data, pos)
+        payload = data[pos + 8:pos + 8 + length]
+        if len(payload) < length:
+            break  # truncated capture
+        yield us, rtype, timeout, payload
+        pos += 8 + length
+
+
+def convert(data, out, epoch_us):
+    if data[:4] != MAGIC or data[4] != VERSION:
+        raise ValueError("not a CR95HF trace (version %d)" % VERSION)
+
+    out.write(block(0x0A0D0D0A, struct.pack("<IHHq", 0x1A2B3C4D, 1, 0, -1)))
+    out.write(block(0x00000001, struct.pack("<HHI", LINKTYPE_USER0, 0, 0) +
+                    option(9, b"\x06") + option(0, b"")))
+
+    count = 0
+    last = None
+    base = epoch_us
+    for us, rtype, timeout, payload in records(data):
+        if last is not None and us < last:
+            base += 1 << 32  # micros() wrapped
+        last = us
+        ts = base + us
+
+        packet = struct.pack("<BBH", rtype, 0, timeout) + payload
+        comment = "%s timeout=%u ms %s" % (TYPES.get(rtype, "type %u" % rtype),
+                                          timeout, payload.hex(" "))
+        body = struct.pack("<IIIII", 0, ts >> 32, ts & 0xFFFFFFFF, len(packet), len(packet))
+        body += packet + b"\0" * (-len(packet) % 4)
+        body += option(1, comment.encode()) + option(0, b"")
+        out.write(block(0x00000006, body))
+        count += 1
+    return count
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("trace")
+    parser.add_argument("pcapng")
+    parser.add_argument("--epoch", type=float, default=0,
+                        help="timestamp of the first micros() tick, in seconds")
+    args = parser.parse_args()
+
+    with open(args.trace, "rb") as f:
+        data = f.read()
+    with open(args.pcapng, "wb") as out:
+        count = convert(data, out, int(args.epoch * 1e6))
+    print("%d records written" % count, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -11,6 +11,25 @@
  */
 
 #include "CR95HF.h"
+#include <new>
+
+// ============================================================================
+// Pre-Encoded Frames
+// ============================================================================
+
+// Out-of-line definitions (needed before C++17 when the arrays are odr-used)
+constexpr uint8_t CR95HF_Frames::IDN[];
+constexpr uint8_t CR95HF_Frames::PROTO_ISO14443A[];
+constexpr uint8_t CR95HF_Frames::PROTO_ISO15693[];
+constexpr uint8_t CR95HF_Frames::PROTO_ISO14443B[];
+constexpr uint8_t CR95HF_Frames::PROTO_FELICA[];
+constexpr uint8_t CR95HF_Frames::PROTO_OFF[];
+constexpr uint8_t CR95HF_Frames::REQA[];
+constexpr uint8_t CR95HF_Frames::WUPA[];
+constexpr uint8_t CR95HF_Frames::ANTICOLL_CL1[];
+constexpr uint8_t CR95HF_Frames::ANTICOLL_CL2[];
+constexpr uint8_t CR95HF_Frames::ANTICOLL_CL3[];
+constexpr uint8_t CR95HF_Frames::HLTA[];
 
 // ============================================================================
 // Constructor
@@ -24,60 +43,282 @@
  * @param baudRate Baud rate (57600 for CR95HF)
  */
 CR95HF::CR95HF(HardwareSerial& port, int rxPin, int txPin, uint32_t baudRate)
-    : _port(&port), _rxPin(rxPin), _txPin(txPin), _baud(baudRate), _debug(false)
+    : CR95HF(*new (_uartStore) CR95HF_UartTransport(port, rxPin, txPin, baudRate)) {
+    // The delegated constructor leaves _uartStore alone, so the transport
+    // built in it above survives
+}
+
+/**
+ * @brief Construct CR95HF driver instance on a custom transport
+ * @param transport Transport instance (must outlive the driver)
+ */
+CR95HF::CR95HF(CR95HF_Transport& transport)
+    : _link(&transport), _debug(false),
+      _statTxUs(0), _statPhase(CR95HF_PHASE_COUNT), _txLen(0),
+      _tmoAdaptive(false), _tmoLastMs(0),
+      _rxPhase(RX_CODE), _rxCode(0), _rxLen(0), _rxCount(0),
+      _asyncStep(ASYNC_IDLE), _asyncStart(0), _asyncTimeout(0), _asyncLevel(0), _asyncCL(NULL),
+      _asyncEnd(CR95HF_ASYNC_IDLE),
+      _tdRef(0), _tdGuard(0x08), _tdValid(false), _arcB(0), _tagHalted(false), _wakeRsp(0), _atqaPending(false),
+      _wakeStrategy(CR95HF_WAKE_WUPA), _wakeToggle(false),
+      _fieldDuty(false), _fieldFresh(false), _guardUs(CR95HF_FIELD_GUARD_US), _fieldOnUs(0),
+      _fieldOnAccUs(0), _idnPending(false), _proto(CR95HF_PROTO_OFF),
+      _isoActive(false), _isoConfigured(false), _isoBlockNum(0), _isoRates(0), _isoFwi(4),
+      _isoFsc(32), _selUidLen(0), _selSak(0),
+      _trackHoldOff(300), _trackMisses(2),
+      _task(NULL), _taskRun(false), _taskDone(NULL), _taskPeriod(150), _eventsDropped(0),
+      _scanCount(0), _scanFirstMs(0), _scanBatches(0), _scanRetries(0),
+      _trace(NULL)
+#if CR95HF_FEATURE_DEBUG
+      , _logDeferred(false), _logTask(NULL), _logTaskRun(false), _logTaskDone(NULL), _logPeriod(100)
+#endif
 {
     memset(lastATQA, 0, sizeof(lastATQA));
+#if CR95HF_FEATURE_DIAGNOSTICS
     memset(deviceName, 0, sizeof(deviceName));
+#endif
+    memset(_tracked, 0, sizeof(_tracked));
+    memset(&_stats, 0, sizeof(_stats));
+    memset(_tmoEnvUs, 0, sizeof(_tmoEnvUs));
+    memset(_pageCache, 0, sizeof(_pageCache));
+    memset(_ident, 0, sizeof(_ident));
 }
 
+/**
+ * @brief Destroy the built-in UART transport, if this driver has one
+ */
+CR95HF::~CR95HF() {
+    if (_link == (CR95HF_Transport*)_uartStore) _link->~CR95HF_Transport();
+}
+
+#if CR95HF_FEATURE_DEBUG
 // ============================================================================
 // Debug Helpers
 // ============================================================================
 
 /**
- * @brief Print debug message if debug mode enabled
- * @param msg Message to print
+ * @brief Log a constant debug message if debug mode enabled
+ * @param msg Message (must be a string literal in deferred mode)
  */
 void CR95HF::log(const char* msg) {
-    if (_debug) Serial.print(msg);
+    if (!_debug) return;
+    if (_logDeferred) {
+        _log.push(CR95HF_LOG_MSG, &msg, sizeof(msg), NULL, 0);
+        return;
+    }
+    Serial.print(msg);
+}
+
+/**
+ * @brief Log a constant format with one numeric argument
+ * @param fmt printf format taking one unsigned long (string literal)
+ * @param value Argument
+ */
+void CR95HF::logValue(const char* fmt, uint32_t value) {
+    if (!_debug) return;
+    if (_logDeferred) {
+        _log.push(CR95HF_LOG_VALUE, &fmt, sizeof(fmt), &value, sizeof(value));
+        return;
+    }
+    Serial.printf(fmt, (unsigned long)value);
+}
+
+/**
+ * @brief Log a sent frame or a received response
+ * @param type CR95HF_LOG_TX or CR95HF_LOG_RX
+ * @param code Response code (RX only)
+ * @param data Frame bytes (TX) or response payload (RX)
+ * @param len Number of bytes
+ */
+void CR95HF::logFrame(uint8_t type, uint8_t code, const uint8_t* data, uint8_t len) {
+    if (!_debug) return;
+    bool rx = (type == CR95HF_LOG_RX);
+    if (_logDeferred) {
+        _log.push(type, &code, rx ? 1 : 0, data, len);
+        return;
+    }
+    if (rx) {
+        Serial.printf("[RX] Code=0x%02X Len=%d ", code, len);
+        printHex(Serial, "Data=", data, len);
+    } else {
+        printHex(Serial, "[TX] ", data, len);
+    }
 }
 
 /**
- * @brief Print hex dump if debug mode enabled
+ * @brief Print hex dump
+ * @param out Output stream
  * @param prefix Prefix string
  * @param data Data to dump
  * @param len Data length
  */
-void CR95HF::logHex(const char* prefix, const uint8_t* data, uint8_t len) {
-    if (!_debug) return;
-    Serial.print(prefix);
+void CR95HF::printHex(Print& out, const char* prefix, const uint8_t* data, uint8_t len) {
+    out.print(prefix);
     for (uint8_t i = 0; i < len; i++) {
-        if (data[i] < 0x10) Serial.print('0');
-        Serial.print(data[i], HEX);
-        Serial.print(' ');
+        if (data[i] < 0x10) out.print('0');
+        out.print(data[i], HEX);
+        out.print(' ');
+    }
+    out.println();
+}
+
+// ============================================================================
+// Deferred Debug Log
+// ============================================================================
+
+/**
+ * @brief Format one deferred record
+ * @param out Output stream
+ * @param type Record type (CR95HF_LOG_*)
+ * @param p Payload
+ * @param len Payload length
+ */
+void CR95HF::printRecord(Print& out, uint8_t type, const uint8_t* p, uint8_t len) {
+    const char* text;
+    uint32_t value;
+
+    switch (type) {
+        case CR95HF_LOG_MSG:
+            memcpy(&text, p, sizeof(text));
+            out.print(text);
+            break;
+        case CR95HF_LOG_VALUE:
+            memcpy(&text, p, sizeof(text));
+            memcpy(&value, p + sizeof(text), sizeof(value));
+            out.printf(text, (unsigned long)value);
+            break;
+        case CR95HF_LOG_TX:
+            printHex(out, "[TX] ", p, len);
+            break;
+        case CR95HF_LOG_RX:
+            out.printf("[RX] Code=0x%02X Len=%d ", p[0], len - 1);
+            printHex(out, "Data=", p + 1, len - 1);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Print and remove deferred log records
+ * @param out Output stream
+ * @param maxRecords Stop after this many records (0 = all)
+ * @return Number of records printed
+ */
+uint16_t CR95HF::flushLog(Print& out, uint16_t maxRecords) {
+    CR95HF_LogHeader h;
+    uint8_t payload[255];
+    uint16_t n = 0;
+
+    while ((maxRecords == 0 || n < maxRecords) && _log.pop(h, payload)) {
+        out.printf("%10lu ", (unsigned long)h.us);
+        printRecord(out, h.type, payload, h.len);
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Log flush task trampoline
+ * @param arg CR95HF instance
+ */
+void CR95HF::logTaskEntry(void* arg) {
+    CR95HF* self = static_cast<CR95HF*>(arg);
+    TickType_t wake = xTaskGetTickCount();
+
+    while (self->_logTaskRun) {
+        self->flushLog();
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(self->_logPeriod));
+    }
+    self->_logTask = NULL;
+    xSemaphoreGive(self->_logTaskDone);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Start the log flush task
+ * @param periodMs Flush period in milliseconds
+ * @param core CPU core
+ * @param priority FreeRTOS priority
+ * @return true if task started
+ */
+bool CR95HF::startLogTask(uint32_t periodMs, BaseType_t core, UBaseType_t priority) {
+    if (_logTask != NULL) return false;
+    if (_logTaskDone == NULL) {
+        _logTaskDone = xSemaphoreCreateBinaryStatic(&_logTaskDoneBuf);
+        if (_logTaskDone == NULL) return false;
+    }
+    xSemaphoreTake(_logTaskDone, 0);
+
+    _logPeriod = periodMs ? periodMs : 1;
+    _logDeferred = true;
+    _logTaskRun = true;
+    if (xTaskCreatePinnedToCore(logTaskEntry, "cr95hf_log", 3072, this,
+                                priority, const_cast<TaskHandle_t*>(&_logTask), core) != pdPASS) {
+        _logTask = NULL;
+        _logTaskRun = false;
+        return false;
     }
-    Serial.println();
+    return true;
+}
+
+/**
+ * @brief Stop the log flush task
+ *
+ * Returns once the task has given _logTaskDone, its last access to the
+ * object.
+ */
+void CR95HF::stopLogTask() {
+    if (_logTask == NULL) return;
+    _logTaskRun = false;
+    xSemaphoreTake(_logTaskDone, portMAX_DELAY);
 }
+#endif // CR95HF_FEATURE_DEBUG
 
 // ============================================================================
 // Low-Level Communication
 // ============================================================================
 
 /**
- * @brief Flush serial receive buffer
+ * @brief Flush receive buffer
  */
 void CR95HF::flushRx() {
-    while (_port->available()) _port->read();
+    _link->flushRx();
+}
+
+/**
+ * @brief Finish reading a reply that outlived its timeout
+ * @param maxMs Longest the rest of it may take
+ * @return true if the late reply arrived (false: nothing came, RX flushed)
+ *
+ * Keeps feeding the response parser, so the next command does not take
+ * the tail of the late reply for its own answer.
+ */
+bool CR95HF::drainRx(uint32_t maxMs) {
+    uint32_t start = millis();
+    for (;;) {
+        bool expired = millis() - start > maxMs;
+        if (rxProcess(_rfBuf, sizeof(_rfBuf))) return true;
+        if (expired) {
+            flushRx();
+            return false;
+        }
+        waitRx(start, maxMs);
+    }
 }
 
 /**
  * @brief Send frame to CR95HF
  * @param frame Frame to send
  */
-void CR95HF::sendFrame(const CR95HF_Frame& frame) {
+void CR95HF::sendFrame(CR95HF_Bytes frame) {
     flushRx();
-    _port->write(frame.data, frame.len);
-    logHex("[TX] ", frame.data, frame.len);
+    statCommand(frame);
+    _txLen = frame.len;
+    _atqaPending = false;   // Any command ends the READY hand-over
+    _link->write(frame.data, frame.len);
+    if (_trace) _trace->record(CR95HF_TRACE_TX, 0, frame.data, frame.len);
+    logFrame(CR95HF_LOG_TX, 0, frame.data, frame.len);
 }
 
 /**
@@ -85,48 +326,269 @@ void CR95HF::sendFrame(const CR95HF_Frame& frame) {
  * @param code Output: response code
  * @param buf Output: response data
  * @param len Input: buffer size, Output: data length
- * @param timeoutMs Timeout in milliseconds
+ * @param timeoutMs Timeout in milliseconds (0 = derived, see replyTimeout())
  * @return true if response received, false on timeout
  */
 bool CR95HF::readResponse(uint8_t& code, uint8_t* buf, uint8_t& len, uint32_t timeoutMs) {
     uint32_t start = millis();
-
-    // Wait for response code
-    while (!_port->available()) {
-        if (millis() - start > timeoutMs) {
-            log("[RX] Timeout waiting for code\n");
+    if (timeoutMs == 0) timeoutMs = replyTimeout(len);
+    _tmoLastMs = timeoutMs;
+
+    rxReset();
+    for (;;) {
+        // Deadline sampled first: bytes in by then are never a timeout,
+        // however long the task was preempted in between
+        bool expired = millis() - start > timeoutMs;
+        if (rxProcess(buf, len)) break;
+        if (expired) {
+            statTimeout();
+            traceRx(false, buf, 0, timeoutMs);
+            if (_rxPhase == RX_CODE) {
+                log("[RX] Timeout waiting for code\n");
+            } else if (_rxPhase == RX_LEN) {
+                log("[RX] Timeout waiting for length\n");
+            } else {
+                log("[RX] Timeout reading payload\n");
+            }
             return false;
         }
+        waitRx(start, timeoutMs);
     }
-    code = _port->read();
+    code = _rxCode;
+    len = (_rxCount < len) ? _rxCount : len;
+    statResponse(code);
+    traceRx(true, buf, len, timeoutMs);
 
-    // Wait for length byte
-    while (!_port->available()) {
-        if (millis() - start > timeoutMs) {
-            log("[RX] Timeout waiting for length\n");
-            return false;
-        }
+    logFrame(CR95HF_LOG_RX, code, buf, len);
+
+    return true;
+}
+
+/**
+ * @brief Read a reply into the shared receive buffer
+ * @param view Output: view into _rfBuf (valid until the next exchange)
+ * @param maxLen Largest payload accepted (also sizes the timeout)
+ * @return true if a complete reply arrived
+ */
+bool CR95HF::readView(CR95HF_ResponseView& view, uint8_t maxLen) {
+    uint8_t code, len = (maxLen < sizeof(_rfBuf)) ? maxLen : sizeof(_rfBuf);
+    if (!readResponse(code, _rfBuf, len)) return false;
+    view = viewOf(code, len);
+    return true;
+}
+
+/**
+ * @brief View of the reply now in the shared receive buffer
+ * @param code Response code
+ * @param len Payload bytes stored
+ * @return View; ISO14443-A tag data has its trailer split off
+ */
+CR95HF_ResponseView CR95HF::viewOf(uint8_t code, uint8_t len) const {
+    CR95HF_ResponseView view = { code, _rfBuf, len, 0 };
+    if (code == CR95HF_RSP_DATA && _proto == CR95HF_PROTO_ISO14443A &&
+        len >= CR95HF_RX_TRAILER_LEN) {
+        view.len = len - CR95HF_RX_TRAILER_LEN;
+        view.status = _rfBuf[view.len];
+    }
+    return view;
+}
+
+/**
+ * @brief Check a tag answer, counting flagged ones
+ * @param view Reply
+ * @param minLen Tag data bytes required
+ * @return true if usable
+ */
+bool CR95HF::tagAnswer(const CR95HF_ResponseView& view, uint8_t minLen) {
+    if (view.code == CR95HF_RSP_DATA && (view.status & CR95HF_RXFLAG_ERRORS)) {
+        _stats.rxStatusError++;
     }
-    uint8_t respLen = _port->read();
+    return view.tagData(minLen);
+}
 
-    // Read payload
-    uint8_t n = 0;
-    while (n < respLen) {
-        if (_port->available()) {
-            buf[n++] = _port->read();
-        } else if (millis() - start > timeoutMs) {
-            log("[RX] Timeout reading payload\n");
-            return false;
+/**
+ * @brief Check the BCC of a cascade level (4 UID bytes + BCC)
+ * @param cl Cascade level bytes
+ * @return true if valid (a wrong one is counted)
+ */
+bool CR95HF::bccOk(const uint8_t* cl) {
+    if ((cl[0] ^ cl[1] ^ cl[2] ^ cl[3]) == cl[4]) return true;
+    _stats.rxBccError++;
+    return false;
+}
+
+/**
+ * @brief Host-side timeout of the reply to the last command
+ * @param rxBytes Largest response payload accepted
+ * @return Milliseconds
+ *
+ * Command, response header and payload over the link plus
+ * CR95HF_TMO_MARGIN_MS. ISO14443-A exchanges add the frame wait time, or
+ * with adaptation on use twice the slowest recent reply of their phase.
+ */
+uint32_t CR95HF::replyTimeout(uint16_t rxBytes) const {
+    uint32_t wire = linkMs(_txLen + 2 + rxBytes);
+    if (_statPhase >= CR95HF_PHASE_COUNT) return wire + CR95HF_TMO_MARGIN_MS;
+
+    uint32_t envUs = _tmoEnvUs[_statPhase];
+    if (!_tmoAdaptive || envUs == 0) return wire + CR95HF_TMO_MARGIN_MS + CR95HF_TMO_RF_MS;
+
+    uint32_t ms = 2 * envUs / 1000 + 1;
+    if (ms < wire) ms = wire;
+    return (ms > CR95HF_TMO_MAX_MS) ? CR95HF_TMO_MAX_MS : ms;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+/**
+ * @brief Count a command and start its latency measurement
+ * @param frame Frame about to be sent
+ */
+void CR95HF::statCommand(CR95HF_Bytes frame) {
+    _statPhase = CR95HF_PHASE_COUNT;
+    if (frame.len < 2) return;
+
+    switch (frame.data[0]) {
+        case CR95HF_CMD_IDN:      _stats.cmdIDN++; break;
+        case CR95HF_CMD_PROTOCOL: _stats.cmdProtocol++; break;
+        case CR95HF_CMD_SENDRECV: _stats.cmdSendRecv++; break;
+        default:                  _stats.cmdOther++; break;
+    }
+
+    // Classify SendRecv by first RF byte (and NVB for SEL commands)
+    if (frame.data[0] == CR95HF_CMD_SENDRECV && frame.len >= 4) {
+        uint8_t rf = frame.data[2];
+        if (rf == ISO14443A_REQA || rf == ISO14443A_WUPA) {
+            _statPhase = CR95HF_PHASE_WAKE;
+        } else if (rf == ISO14443A_SEL_CL1 || rf == ISO14443A_SEL_CL2 ||
+                   rf == ISO14443A_SEL_CL3) {
+            _statPhase = (frame.data[3] == ISO14443A_NVB_SELECT) ? CR95HF_PHASE_SELECT
+                                                                  : CR95HF_PHASE_ANTICOLL;
         }
     }
-    len = n;
+    _statTxUs = micros();
+}
 
-    if (_debug) {
-        Serial.printf("[RX] Code=0x%02X Len=%d ", code, len);
-        logHex("Data=", buf, len);
+/**
+ * @brief Count a response code and record the exchange latency
+ * @param code Response code
+ */
+void CR95HF::statResponse(uint8_t code) {
+    switch (code) {
+        case CR95HF_RSP_SUCCESS:     _stats.rspSuccess++; break;
+        case CR95HF_RSP_DATA:        _stats.rspData++; break;
+        case CR95HF_RSP_TIMEOUT:     _stats.rspTimeout++; break;
+        case CR95HF_RSP_COLLISION:   _stats.rspCollision++; break;
+        case CR95HF_RSP_FRAMEERR:    _stats.rspFrameErr++; break;
+        case CR95HF_RSP_INVALID_LEN: _stats.rspInvalidLen++; break;
+        default:                     _stats.rspOther++; break;
     }
 
-    return true;
+    if (_statPhase >= CR95HF_PHASE_COUNT) return;
+
+    uint32_t us = micros() - _statTxUs;
+    uint8_t bucket = 0;
+    for (uint32_t t = us >> 8; t && bucket < CR95HF_HIST_BUCKETS - 1; t >>= 1) {
+        bucket++;
+    }
+    _stats.latency[_statPhase][bucket]++;
+    if (us > _stats.latencyMaxUs[_statPhase]) _stats.latencyMaxUs[_statPhase] = us;
+    _stats.latencyLastUs[_statPhase] = us;
+
+    // Slowest recent reply: jumps up at once, decays slowly
+    uint32_t& env = _tmoEnvUs[_statPhase];
+    env = (us >= env) ? us : env - ((env - us) >> CR95HF_TMO_DECAY_SHIFT);
+    _statPhase = CR95HF_PHASE_COUNT;
+}
+
+/**
+ * @brief Count a host-side read timeout in the current parser phase
+ */
+void CR95HF::statTimeout() {
+    if (_rxPhase == RX_CODE) {
+        _stats.rxTimeoutCode++;
+    } else if (_rxPhase == RX_LEN) {
+        _stats.rxTimeoutLen++;
+    } else {
+        _stats.rxTimeoutPayload++;
+    }
+
+    // Reply missed: relearn the phase from the ceiling down
+    if (_statPhase < CR95HF_PHASE_COUNT) {
+        _tmoEnvUs[_statPhase] = CR95HF_TMO_MAX_MS * 500UL;
+    }
+    _statPhase = CR95HF_PHASE_COUNT;
+}
+
+/**
+ * @brief Record a response (or its absence) in the frame trace
+ * @param ok Complete response received
+ * @param buf Payload bytes stored
+ * @param len Number of payload bytes stored
+ * @param timeoutMs Timeout of the exchange
+ */
+void CR95HF::traceRx(bool ok, const uint8_t* buf, uint8_t len, uint32_t timeoutMs) {
+    if (!_trace) return;
+    uint16_t tmo = (timeoutMs > 0xFFFF) ? 0xFFFF : (uint16_t)timeoutMs;
+    if (!ok) {
+        _trace->record(CR95HF_TRACE_RX_TIMEOUT, tmo, NULL, 0);
+        return;
+    }
+    uint8_t hdr[2] = {_rxCode, _rxLen};
+    _trace->record(CR95HF_TRACE_RX, tmo, hdr, 2, buf, (len < 253) ? len : 253);
+}
+
+/**
+ * @brief Wait for receive data
+ * @param start millis() at start of the exchange
+ * @param timeoutMs Exchange timeout in milliseconds
+ *
+ * Delegates to the transport with the time left until the deadline.
+ * Returns immediately in polling mode or when data is already buffered.
+ */
+void CR95HF::waitRx(uint32_t start, uint32_t timeoutMs) {
+    uint32_t elapsed = millis() - start;
+    if (elapsed > timeoutMs) return;
+    _link->waitRx(timeoutMs - elapsed);
+}
+
+/**
+ * @brief Reset response parser for a new frame
+ */
+void CR95HF::rxReset() {
+    _rxPhase = RX_CODE;
+    _rxCode = 0;
+    _rxLen = 0;
+    _rxCount = 0;
+}
+
+/**
+ * @brief Consume buffered bytes into the response parser (non-blocking)
+ * @param buf Payload buffer
+ * @param size Payload buffer size (excess bytes are discarded)
+ * @return true once code, length and full payload have been received
+ */
+bool CR95HF::rxProcess(uint8_t* buf, uint8_t size) {
+    while (_rxPhase != RX_DONE && _link->available() > 0) {
+        uint8_t b = (uint8_t)_link->read();
+        switch (_rxPhase) {
+            case RX_CODE:
+                _rxCode = b;
+                _rxPhase = RX_LEN;
+                break;
+            case RX_LEN:
+                _rxLen = b;
+                _rxPhase = (b == 0) ? RX_DONE : RX_PAYLOAD;
+                break;
+            default:
+                if (_rxCount < size) buf[_rxCount] = b;
+                if (++_rxCount >= _rxLen) _rxPhase = RX_DONE;
+                break;
+        }
+    }
+    return _rxPhase == RX_DONE;
 }
 
 // ============================================================================
@@ -135,21 +597,27 @@ bool CR95HF::readResponse(uint8_t& code, uint8_t* buf, uint8_t& len, uint32_t ti
 
 /**
  * @brief Perform echo test to verify CR95HF communication
+ * @param timeoutMs Wait for the echo
  * @return true if CR95HF responds with echo
  */
-bool CR95HF::echoTest() {
+bool CR95HF::echoTest(uint32_t timeoutMs) {
+    static const uint8_t echo = CR95HF_CMD_ECHO;
     flushRx();
-    _port->write((uint8_t)CR95HF_CMD_ECHO);
+    _link->write(&echo, 1);
+    if (_trace) _trace->record(CR95HF_TRACE_TX, 0, &echo, 1);
 
     uint32_t start = millis();
-    while (millis() - start < 50) {
-        if (_port->available()) {
-            uint8_t resp = _port->read();
+    for (;;) {
+        bool expired = millis() - start >= timeoutMs;
+        while (_link->available() > 0) {
+            uint8_t resp = (uint8_t)_link->read();
             if (resp == CR95HF_CMD_ECHO) {
                 log("[CR95HF] Echo OK\n");
                 return true;
             }
         }
+        if (expired) break;
+        waitRx(start, timeoutMs);
     }
     log("[CR95HF] Echo FAILED\n");
     return false;
@@ -159,277 +627,2296 @@ bool CR95HF::echoTest() {
 // Initialization
 // ============================================================================
 
+/**
+ * @brief CR95HF UART clock used for baud rate generation
+ */
+static const uint32_t CR95HF_UART_CLOCK = 13560000UL;
+
+/**
+ * @brief Compute BaudRate command divider
+ * @param baud Requested baud rate
+ * @param actual Output: baud rate the CR95HF will really use
+ * @return Divider, or -1 if no divider is within 3% of the request
+ */
+static int baudDivider(uint32_t baud, uint32_t& actual) {
+    if (baud == 0) return -1;
+
+    // baud = clock / (2 * n + 2)  =>  n = clock / (2 * baud) - 1 (rounded)
+    int32_t n = (int32_t)((CR95HF_UART_CLOCK + baud) / (2 * baud)) - 1;
+    if (n < 0 || n > 255) return -1;
+
+    actual = CR95HF_UART_CLOCK / (2 * (uint32_t)n + 2);
+    uint32_t diff = (actual > baud) ? actual - baud : baud - actual;
+    if (diff * 100 > baud * 3) return -1;
+
+    return n;
+}
+
 /**
  * @brief Initialize CR95HF transceiver
  * @param debug Enable debug output
+ * @param targetBaud Baud rate to switch to after init (0 = keep)
  * @return true if initialization successful
  */
-bool CR95HF::begin(bool debug) {
+bool CR95HF::begin(bool debug, uint32_t targetBaud) {
     _debug = debug;
 
-    // CR95HF requires UART 8N2 (2 stop bits!) - critical!
-    _port->begin(_baud, SERIAL_8N2, _rxPin, _txPin);
-    delay(20);  // Wait for UART stabilization
+    if (!_link->begin()) {
+        log("[CR95HF] Transport init failed\n");
+        return false;
+    }
+    delay(20);  // Wait for link stabilization
     flushRx();
 
     // Step 1: Echo test - verify basic communication
     if (!echoTest()) {
-        return false;
+        // CR95HF may still run at targetBaud if only the MCU was reset
+        uint32_t actual;
+        uint32_t base = _link->baudRate();
+        if (targetBaud == 0 || baudDivider(targetBaud, actual) < 0 ||
+            !_link->setBaudRate(actual)) {
+            return false;
+        }
+        delay(2);
+        if (!echoTest()) {
+            _link->setBaudRate(base);
+            return false;
+        }
     }
 
     // Step 2: Get IDN - read device identification
-    _txFrame.buildIDN();
-    sendFrame(_txFrame);
+    sendFrame(CR95HF_Frames::IDN);
 
     uint8_t code, buf[32], len = sizeof(buf);
-    if (!readResponse(code, buf, len, 100) || code != CR95HF_RSP_SUCCESS || len < 10) {
+    if (!readResponse(code, buf, len) || code != CR95HF_RSP_SUCCESS || len < 10) {
         log("[CR95HF] IDN failed\n");
         return false;
     }
 
+#if CR95HF_FEATURE_DIAGNOSTICS
     // Store device name (null-terminate)
     uint8_t copyLen = (len < sizeof(deviceName) - 1) ? len : sizeof(deviceName) - 1;
     memcpy(deviceName, buf, copyLen);
     deviceName[copyLen] = '\0';
+#endif
+    _idnPending = false;
 
+#if CR95HF_FEATURE_DEBUG && CR95HF_FEATURE_DIAGNOSTICS
     if (_debug) {
         Serial.printf("[CR95HF] Device: %s\n", deviceName);
     }
+#endif
+
+    // Step 3: Select ISO14443A protocol (chip state unknown: always sent)
+    if (!selectProtocol(CR95HF_PROTO_ISO14443A, true)) {
+        log("[CR95HF] Protocol select failed\n");
+        return false;
+    }
+    log("[CR95HF] ISO14443A ready\n");
+
+    // Step 4: Optional faster link (failure keeps the current rate)
+    if (targetBaud != 0 && targetBaud != _link->baudRate()) {
+        setBaudRate(targetBaud);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Initialize from a state saved before deep sleep
+ * @param state Saved state
+ * @param debug Enable debug output
+ * @return true if initialization successful
+ */
+bool CR95HF::beginFast(const CR95HF_WarmState& state, bool debug) {
+    if (state.magic != CR95HF_WARM_MAGIC) return begin(debug);
+    _debug = debug;
+
+    if (!_link->begin()) {
+        log("[CR95HF] Transport init failed\n");
+        return false;
+    }
+    uint32_t base = _link->baudRate();
+    uint32_t actual;
+    if (state.baud != base &&
+        (baudDivider(state.baud, actual) < 0 || !_link->setBaudRate(actual))) {
+        return begin(debug);
+    }
+    flushRx();
+
+    // One echo: a CR95HF that lost power (or its baud rate) needs the full init
+    if (!echoTest(linkMs(2) + CR95HF_TMO_MARGIN_MS)) {
+        log("[CR95HF] Warm start failed, full init\n");
+        _link->setBaudRate(base);
+        return begin(debug, state.baud);
+    }
+
+#if CR95HF_FEATURE_DIAGNOSTICS
+    memcpy(deviceName, state.deviceName, sizeof(deviceName));
+    deviceName[sizeof(deviceName) - 1] = '\0';
+#endif
+    _arcB = state.arcB;
+    _tdRef = state.tdRef;
+    _tdGuard = state.tdGuard;
+    _tdValid = state.tdValid;
+
+    if (!selectProtocol(CR95HF_PROTO_ISO14443A, true)) {
+        log("[CR95HF] Protocol select failed\n");
+        return false;
+    }
+    if (state.proto == CR95HF_PROTO_ISO14443A) _fieldFresh = false;  // Field stayed on
+    _idnPending = true;     // Checked after the first empty poll
+    log("[CR95HF] Warm start, ISO14443A ready\n");
+    return true;
+}
+
+/**
+ * @brief Save the state beginFast() needs
+ * @param state Output
+ */
+void CR95HF::saveWarmState(CR95HF_WarmState& state) const {
+    memset(&state, 0, sizeof(state));
+    state.magic = CR95HF_WARM_MAGIC;
+    state.baud = _link->baudRate();
+#if CR95HF_FEATURE_DIAGNOSTICS
+    memcpy(state.deviceName, deviceName, sizeof(state.deviceName));
+#endif
+    state.proto = _proto;
+    state.arcB = _arcB;
+    state.tdRef = _tdRef;
+    state.tdGuard = _tdGuard;
+    state.tdValid = _tdValid;
+}
+
+/**
+ * @brief Deferred IDN check of beginFast()
+ *
+ * Runs once, after a poll found the field empty, so it never delays a
+ * tag read. A different IDN replaces the cached device name (without
+ * CR95HF_FEATURE_DIAGNOSTICS, only the answer itself is checked).
+ */
+void CR95HF::warmCheck() {
+    _idnPending = false;
+    char name[sizeof(CR95HF_WarmState::deviceName)];
+    if (!readIDN(name, sizeof(name))) {
+        log("[CR95HF] Warm start IDN check failed\n");
+        return;
+    }
+    warmCompare(name);
+}
+
+/**
+ * @brief Compare the IDN read after a warm start with the saved one
+ * @param name IDN answer (NUL-terminated)
+ */
+void CR95HF::warmCompare(const char* name) {
+#if CR95HF_FEATURE_DIAGNOSTICS
+    if (strcmp(name, deviceName) != 0) {
+        log("[CR95HF] IDN changed since warm start\n");
+        memcpy(deviceName, name, sizeof(deviceName));
+    }
+#else
+    (void)name;
+#endif
+}
+
+// ============================================================================
+// Baud Rate
+// ============================================================================
+
+/**
+ * @brief Switch CR95HF and host UART to a new baud rate
+ * @param baud Requested baud rate
+ * @return true if link verified at the new rate
+ */
+bool CR95HF::setBaudRate(uint32_t baud) {
+    uint32_t actual;
+    int divider = baudDivider(baud, actual);
+    if (divider < 0) {
+        log("[CR95HF] Baud rate not reachable\n");
+        return false;
+    }
+
+    uint32_t previous = _link->baudRate();
+    if (previous == 0) return false;    // Not a UART transport
+    if (actual == previous) return true;
+
+    _txFrame.buildBaudRate((uint8_t)divider);
+    sendFrame(_txFrame);
+    _link->flushTx();               // Command fully on the wire at old rate
+    _link->setBaudRate(actual);
+    delay(2);                       // 0x55 answer arrives at new rate; discard it
+    flushRx();
+
+    if (echoTest()) {
+        logValue("[CR95HF] Baud rate %lu\n", actual);
+        return true;
+    }
+
+    // Fallback 1: command not taken, chip still at the previous rate
+    _link->setBaudRate(previous);
+    delay(2);
+    flushRx();
+    if (echoTest()) {
+        log("[CR95HF] Baud rate rejected, kept previous\n");
+        return false;
+    }
+
+    // Fallback 2: chip switched but link is unreliable - send the previous
+    // rate blind at the new rate, then verify at the previous rate
+    uint32_t prevActual;
+    int prevDivider = baudDivider(previous, prevActual);
+    if (prevDivider >= 0) {
+        _link->setBaudRate(actual);
+        _txFrame.buildBaudRate((uint8_t)prevDivider);
+        sendFrame(_txFrame);
+        _link->flushTx();
+        _link->setBaudRate(previous);
+        delay(2);
+        flushRx();
+    }
+
+    if (!echoTest()) {
+        log("[CR95HF] Baud rate fallback failed\n");
+    }
+    return false;
+}
+
+// ============================================================================
+// Event-Driven Receive
+// ============================================================================
+
+/**
+ * @brief Enable or disable event-driven receive
+ * @param enable true for event mode, false for polling mode
+ * @return true if mode applied
+ */
+bool CR95HF::setRxEvents(bool enable) {
+    if (!_link->setRxEvents(enable)) return false;
+    log(enable ? "[CR95HF] Event-driven RX enabled\n" : "[CR95HF] Polling RX\n");
+    return true;
+}
+
+// ============================================================================
+// Protocol Selection
+// ============================================================================
+
+/**
+ * @brief Select an RF protocol, skipping the command if already selected
+ * @param proto CR95HF_PROTO_ISO14443A / ISO15693 / ISO14443B / FELICA
+ * @param force Send ProtocolSelect even if nothing would change
+ * @return true if the protocol is selected
+ *
+ * ISO14443-A reprogrammed by isoDepConfigure() always goes back to the
+ * default settings. Changing protocol loses any tag selection.
+ */
+bool CR95HF::selectProtocol(uint8_t proto, bool force) {
+    if (!force && proto == _proto && !_isoConfigured) return true;
+
+    CR95HF_Bytes frame = CR95HF_Frames::PROTO_ISO14443A;
+    switch (proto) {
+        case CR95HF_PROTO_ISO14443A: break;
+#if CR95HF_FEATURE_ISO15693
+        case CR95HF_PROTO_ISO15693:  frame = CR95HF_Frames::PROTO_ISO15693; break;
+#endif
+#if CR95HF_FEATURE_ISO14443B
+        case CR95HF_PROTO_ISO14443B: frame = CR95HF_Frames::PROTO_ISO14443B; break;
+#endif
+#if CR95HF_FEATURE_FELICA
+        case CR95HF_PROTO_FELICA:    frame = CR95HF_Frames::PROTO_FELICA; break;
+#endif
+        default: return false;
+    }
+    sendFrame(frame);
+
+    uint8_t code, buf[8], len = sizeof(buf);
+    if (!readResponse(code, buf, len)) return false;
+    if (code != CR95HF_RSP_SUCCESS) return false;
+    protocolSelected(proto);
+
+    // ProtocolSelect reloaded the default ARC_B
+    if (proto == CR95HF_PROTO_ISO14443A && _arcB) return writeArcB(_arcB);
+    return true;
+}
+
+/**
+ * @brief Track a ProtocolSelect the CR95HF confirmed
+ * @param proto Protocol now selected
+ */
+void CR95HF::protocolSelected(uint8_t proto) {
+    if (proto != _proto) {
+        _isoActive = false;
+        _selUidLen = 0;
+    }
+    if (_proto == CR95HF_PROTO_OFF) {
+        _fieldOnUs = micros();      // Field just came on: tags powering up
+        _fieldFresh = true;
+    }
+    _proto = proto;
+    _isoConfigured = false;  // ISO14443-A: back to 106 kbps, default FWT
+}
+
+/**
+ * @brief Switch the RF field off and on again
+ * @return true if ISO14443-A is selected again
+ *
+ * Every tag loses power and restarts in IDLE, including halted ones.
+ */
+bool CR95HF::fieldReset() {
+    fieldOff();
+    delay(CR95HF_FIELD_RESET_MS);
+
+    if (!selectProtocol(CR95HF_PROTO_ISO14443A)) return false;
+    delay(CR95HF_FIELD_RESET_MS);  // Tag power-up before the first command
+    _tagHalted = false;
+    return true;
+}
+
+/**
+ * @brief Bring the RF field up ahead of a poll
+ * @param proto Protocol to select
+ * @return true if the field is on
+ */
+bool CR95HF::fieldOn(uint8_t proto) {
+    return selectProtocol(proto);
+}
+
+/**
+ * @brief Switch the RF field off
+ * @return true if the CR95HF confirmed
+ */
+bool CR95HF::fieldOff() {
+    if (_proto == CR95HF_PROTO_OFF) return true;
+
+    sendFrame(CR95HF_Frames::PROTO_OFF);
+    uint8_t code, buf[8], len = sizeof(buf);
+    bool ok = readResponse(code, buf, len) && code == CR95HF_RSP_SUCCESS;
+    fieldWentOff();
+    _tagHalted = false;     // Unpowered tags restart in IDLE
+    return ok;
+}
+
+/**
+ * @brief Account for the field going off (PROTO_OFF or Idle)
+ */
+void CR95HF::fieldWentOff() {
+    if (_proto != CR95HF_PROTO_OFF) _fieldOnAccUs += micros() - _fieldOnUs;
+    _proto = CR95HF_PROTO_OFF;
+    _fieldFresh = false;
+}
+
+/**
+ * @brief Wait out the tag power-up time left after the last field-on
+ */
+void CR95HF::fieldGuard() {
+    if (!_fieldFresh) return;
+    uint32_t on = micros() - _fieldOnUs;
+    if (on < _guardUs) delayMicroseconds(_guardUs - on);
+    _fieldFresh = false;
+}
+
+/**
+ * @brief Total time the RF field has been on
+ * @return Milliseconds
+ */
+uint32_t CR95HF::fieldOnMs() const {
+    uint64_t us = _fieldOnAccUs;
+    if (_proto != CR95HF_PROTO_OFF) us += micros() - _fieldOnUs;
+    return (uint32_t)(us / 1000);
+}
+
+// ============================================================================
+// REQA / WUPA - Tag Wake Commands
+// ============================================================================
+
+/**
+ * @brief Send REQA or WUPA command
+ * @param cmd Command (ISO14443A_REQA or ISO14443A_WUPA)
+ * @param atqa1 Output: ATQA byte 1
+ * @param atqa2 Output: ATQA byte 2
+ * @return true if tag responded
+ */
+bool CR95HF::sendReqWup(uint8_t cmd, uint8_t& atqa1, uint8_t& atqa2) {
+    _wakeRsp = 0;
+    isoDepReset();  // Wake-up always runs at ISO14443-3 settings
+    if (!selectProtocol(CR95HF_PROTO_ISO14443A)) return false;
+    _selUidLen = 0;
+    fieldGuard();
+
+    sendFrame(cmd == ISO14443A_WUPA ? CR95HF_Bytes(CR95HF_Frames::WUPA)
+                                    : CR95HF_Bytes(CR95HF_Frames::REQA));
+
+    CR95HF_ResponseView rsp;
+    if (!readView(rsp)) return false;
+    _wakeRsp = rsp.code;
+
+    // Any ATQA counts: several tags answering collide here by design
+    if (rsp.code != CR95HF_RSP_DATA || rsp.len < 2) return false;
+
+    atqa1 = lastATQA[0] = rsp.data[0];
+    atqa2 = lastATQA[1] = rsp.data[1];
+    _tagHalted = false;  // Tag is READY now, heading to ACTIVE
+    _atqaPending = true;
+    return true;
+}
+
+/**
+ * @brief Wake-up command for the next UID read
+ * @return ISO14443A_WUPA or ISO14443A_REQA, per the wake strategy
+ */
+uint8_t CR95HF::wakeCommand() {
+    switch (_wakeStrategy) {
+        case CR95HF_WAKE_REQA:
+            return ISO14443A_REQA;
+        case CR95HF_WAKE_ALTERNATE:
+            _wakeToggle = !_wakeToggle;
+            return _wakeToggle ? ISO14443A_WUPA : ISO14443A_REQA;
+        default:
+            return ISO14443A_WUPA;
+    }
+}
+
+/**
+ * @brief Empty-field check in one exchange
+ * @return true if no tag answered
+ *
+ * A garbled answer or a missing CR95HF reply counts as not empty: the
+ * caller's UID read finds out what is there.
+ */
+bool CR95HF::fieldIsEmpty() {
+    uint8_t atqa1, atqa2;
+    if (sendReqWup(wakeCommand(), atqa1, atqa2)) return false;  // Left READY
+    if (_wakeRsp != CR95HF_RSP_TIMEOUT) return false;
+    if (_idnPending) warmCheck();
+    if (_fieldDuty) fieldOff();
+    return true;
+}
+
+// ============================================================================
+// Anticollision & Select - One Cascade Level
+// ============================================================================
+
+/**
+ * @brief SEL code of a cascade level
+ * @param level 0-2
+ * @return ISO14443A_SEL_CL1 / CL2 / CL3
+ */
+static uint8_t selCode(uint8_t level) {
+    return ISO14443A_SEL_CL1 + 2 * level;
+}
+
+/**
+ * @brief Anticollision frame of a cascade level, no UID bits known
+ * @param level 0-2
+ */
+static CR95HF_Bytes anticollFrame(uint8_t level) {
+    switch (level) {
+        case 0:  return CR95HF_Frames::ANTICOLL_CL1;
+        case 1:  return CR95HF_Frames::ANTICOLL_CL2;
+        default: return CR95HF_Frames::ANTICOLL_CL3;
+    }
+}
+
+/**
+ * @brief UID bytes carried by a cascade level
+ * @param level 0-2
+ * @param cl 5 bytes of the level
+ * @return 3 after a cascade tag (more levels follow), else 4
+ *
+ * The last level has no cascade tag, whatever its first byte.
+ */
+static uint8_t levelBytes(uint8_t level, const uint8_t* cl) {
+    return (level + 1 < ISO14443A_CASCADE_LEVELS && cl[0] == ISO14443A_CT) ? 3 : 4;
+}
+
+/**
+ * @brief Anticollision and select of one cascade level
+ * @param level 0-2 (CL1 / CL2 / CL3)
+ * @param uid Output: UID bytes of this level, written in place
+ * @param n Output: bytes written (3 after a cascade tag, else 4)
+ * @param sak Output: SAK byte
+ * @return true if selected
+ *
+ * The anticollision answer is checked (trailer flags, BCC) while still in
+ * the receive buffer; the UID bytes go straight to the caller and the
+ * SELECT frame is built from the same bytes.
+ */
+bool CR95HF::cascadeLevel(uint8_t level, uint8_t* uid, uint8_t& n, uint8_t& sak) {
+    sendFrame(anticollFrame(level));
+
+    CR95HF_ResponseView rsp;
+    if (!readView(rsp) || !tagAnswer(rsp, 5) || !bccOk(rsp.data)) return false;
+
+    // Cascade tag (0x88): 3 UID bytes here, more follow
+    const uint8_t* cl = rsp.data;
+    n = levelBytes(level, cl);
+    memcpy(uid, &cl[4 - n], n);
+
+    return selectLevel(selCode(level), cl, sak);
+}
+
+/**
+ * @brief SELECT one cascade level
+ * @param sel ISO14443A_SEL_CL1 / CL2 / CL3
+ * @param cl 5 bytes: UID bytes (or CT + 3 bytes) + BCC
+ * @param sak Output: SAK byte
+ * @return true if successful
+ */
+bool CR95HF::selectLevel(uint8_t sel, const uint8_t* cl, uint8_t& sak) {
+    sendFrame(CR95HF_SelectFrame(sel, cl));
+
+    CR95HF_ResponseView rsp;
+    if (!readView(rsp) || !tagAnswer(rsp, 1)) return false;
+
+    sak = rsp.data[0];
+    return true;
+}
+
+// ============================================================================
+// Get UID (4-byte, 7-byte or 10-byte)
+// ============================================================================
+
+/**
+ * @brief Read ISO14443-A tag UID
+ * @param uid Output buffer (min 10 bytes)
+ * @param uidLen Output: UID length (4, 7 or 10)
+ * @param sakOut Output: SAK byte
+ * @return true if tag detected and UID read
+ *
+ * Algorithm:
+ * 1. Wake per the strategy (unless fieldIsEmpty() left a tag READY); after
+ *    a garbled WUPA answer, REQA once
+ * 2. Anticollision + select per cascade level, UID bytes written straight
+ *    to uid; a cascade tag (0x88) leads to the next level (CL2, CL3)
+ * Answers with collision / CRC / parity flags or a wrong BCC are rejected.
+ */
+bool CR95HF::iso14443aGetUID(uint8_t* uid, uint8_t& uidLen, uint8_t& sakOut) {
+    uidLen = 0;
+    sakOut = 0;
+
+    // WUPA wakes every tag REQA would, so REQA only follows a garbled
+    // answer, not a silent field
+    uint8_t atqa1 = lastATQA[0], atqa2 = lastATQA[1];
+    bool gotAtqa = _atqaPending;    // Tag already READY (fieldIsEmpty())
+    if (!gotAtqa) {
+        uint8_t wake = wakeCommand();
+        gotAtqa = sendReqWup(wake, atqa1, atqa2);
+        if (!gotAtqa && wake == ISO14443A_WUPA && _wakeRsp != CR95HF_RSP_TIMEOUT) {
+            gotAtqa = sendReqWup(ISO14443A_REQA, atqa1, atqa2);
+        }
+    }
+    if (!gotAtqa) {
+        if (_idnPending) warmCheck();
+        if (_fieldDuty) fieldOff();
+        return false;  // No tag in field
+    }
+
+    // Store ATQA for debugging
+    lastATQA[0] = atqa1;
+    lastATQA[1] = atqa2;
+
+    // Cascade tag + 3 bytes per level until one carries the last 4 bytes:
+    // 4-byte UID in CL1, 7-byte in CL1-CL2, 10-byte in CL1-CL3
+    uint8_t n = 3, sak;
+    for (uint8_t level = 0; n == 3; level++) {
+        if (!cascadeLevel(level, &uid[uidLen], n, sak)) {
+            uidLen = 0;
+            return false;
+        }
+        uidLen += n;
+    }
+
+    sakOut = sak;
+    setSelected(uid, uidLen, sak);
+    return true;
+}
+
+/**
+ * @brief Read ISO14443-A tag UID (without SAK)
+ * @param uid Output buffer (min 10 bytes)
+ * @param uidLen Output: UID length
+ * @return true if tag detected
+ */
+bool CR95HF::iso14443aGetUID(uint8_t* uid, uint8_t& uidLen) {
+    uint8_t sak;
+    return iso14443aGetUID(uid, uidLen, sak);
+}
+
+// ============================================================================
+// Multi-Tag Inventory
+// ============================================================================
+
+/**
+ * @brief Resolve one cascade level, following collisions bit by bit
+ * @param sel Select code (ISO14443A_SEL_CL*)
+ * @param cl Output: 5 bytes (4 UID bytes + BCC)
+ * @return true if all 40 bits known and BCC valid
+ *
+ * Received bits are appended after the bits already sent. On a collision,
+ * the bits before it are kept, the colliding bit is set to 1 and the next
+ * anticollision frame carries all known bits, so only the tags of that
+ * branch keep answering. At most one round trip per colliding bit.
+ */
+bool CR95HF::anticollResolve(uint8_t sel, uint8_t* cl) {
+    uint8_t knownBits = 0;
+    memset(cl, 0, 5);
+
+    while (knownBits < 40) {
+        _txFrame.buildAnticoll(sel, cl, knownBits);
+        sendFrame(_txFrame);
+
+        CR95HF_ResponseView rsp;
+        if (!readView(rsp)) return false;
+        const uint8_t* buf = rsp.data;
+
+        uint16_t take;
+        bool collision;
+        if (rsp.code == CR95HF_RSP_DATA && rsp.len > 0) {
+            // Collision position follows the flags byte in the trailer
+            uint8_t lastBits = rsp.status & CR95HF_RXFLAG_BITS_MASK;
+            collision = (rsp.status & CR95HF_RXFLAG_COLLISION) != 0;
+            take = collision ? buf[rsp.len + 1] * 8 + buf[rsp.len + 2]
+                             : (rsp.len - 1) * 8 + (lastBits ? lastBits : 8);
+            if (take > rsp.len * 8) take = rsp.len * 8;
+        } else if (rsp.code == CR95HF_RSP_COLLISION) {
+            collision = true;   // No position reported: split at next bit
+            take = 0;
+        } else {
+            return false;
+        }
+
+        // Append bits received before the collision (or all of them)
+        for (uint16_t k = 0; k < take && knownBits < 40; k++, knownBits++) {
+            uint8_t bit = (buf[k / 8] >> (k % 8)) & 0x01;
+            if (bit) {
+                cl[knownBits / 8] |= (1 << (knownBits % 8));
+            } else {
+                cl[knownBits / 8] &= ~(1 << (knownBits % 8));
+            }
+        }
+
+        if (collision && knownBits < 40) {
+            cl[knownBits / 8] |= (1 << (knownBits % 8));  // Take branch 1
+            knownBits++;
+        } else if (!collision) {
+            break;
+        }
+    }
+
+    return knownBits >= 40 && bccOk(cl);
+}
+
+/**
+ * @brief Anticollision + select over all cascade levels of one tag
+ * @param tag Output: UID and SAK
+ * @return true if tag selected
+ */
+bool CR95HF::selectResolved(CR95HF_UIDResult& tag) {
+    uint8_t cl[5];
+
+    tag.uidLen = 0;
+    for (uint8_t level = 0; level < ISO14443A_CASCADE_LEVELS; level++) {
+        if (!anticollResolve(selCode(level), cl)) return false;
+
+        if (!selectLevel(selCode(level), cl, tag.sak)) return false;
+
+        uint8_t n = levelBytes(level, cl);
+        memcpy(&tag.uid[tag.uidLen], &cl[4 - n], n);  // Skip cascade tag
+        tag.uidLen += n;
+        if (n == 4) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Send HLTA to the currently selected tag
+ * @return true if the CR95HF processed the command
+ */
+bool CR95HF::halt() {
+    sendFrame(CR95HF_Frames::HLTA);
+
+    // A halted tag stays silent: timeout from the CR95HF is the normal answer
+    uint8_t code, buf[8], len = sizeof(buf);
+    _tagHalted = readResponse(code, buf, len);
+    _selUidLen = 0;
+    return _tagHalted;
+}
+
+// ============================================================================
+// Presence Check
+// ============================================================================
+
+/**
+ * @brief Check that an already-read tag is still in the field
+ * @param uid Cached UID
+ * @param uidLen UID length (4, 7 or 10)
+ * @return true if that tag answered
+ */
+bool CR95HF::isStillPresent(const uint8_t* uid, uint8_t uidLen) {
+    if (!selectKnown(uid, uidLen)) return false;
+    halt();
+    return true;
+}
+
+/**
+ * @brief Wake and select a tag by its known UID (no anticollision)
+ * @param uid UID
+ * @param uidLen UID length (4, 7 or 10)
+ * @return true if that tag is selected (ACTIVE)
+ */
+bool CR95HF::selectKnown(const uint8_t* uid, uint8_t uidLen) {
+    if (!uid || (uidLen != 4 && uidLen != 7 && uidLen != 10)) return false;
+
+    // A halted tag answers the first WUPA. One left ACTIVE by a previous
+    // read ignores it and drops to IDLE, so it needs a second one.
+    uint8_t atqa1, atqa2;
+    bool woken = sendReqWup(ISO14443A_WUPA, atqa1, atqa2);
+    if (!woken && !_tagHalted) {
+        woken = sendReqWup(ISO14443A_WUPA, atqa1, atqa2);
+    }
+    if (!woken) return false;
+
+    // SELECT straight from READY with the cached UID: cascade tag + 3 bytes
+    // per level, the last level the remaining 4
+    uint8_t cl[5], sak;
+    uint8_t last = (uidLen - 4) / 3;
+    for (uint8_t level = 0; level <= last; level++) {
+        const uint8_t* part = &uid[3 * level];
+        if (level < last) {
+            cl[0] = ISO14443A_CT;
+            memcpy(&cl[1], part, 3);
+        } else {
+            memcpy(cl, part, 4);
+        }
+        cl[4] = cl[0] ^ cl[1] ^ cl[2] ^ cl[3];
+        if (!selectLevel(selCode(level), cl, sak)) return false;
+    }
+
+    setSelected(uid, uidLen, sak);
+    return true;
+}
+
+/**
+ * @brief Remember the tag now ACTIVE
+ * @param uid UID (may be _selUid itself)
+ * @param uidLen UID length
+ * @param sak SAK of the last cascade level
+ */
+void CR95HF::setSelected(const uint8_t* uid, uint8_t uidLen, uint8_t sak) {
+    memmove(_selUid, uid, uidLen);
+    _selUidLen = uidLen;
+    _selSak = sak;
+}
+
+/**
+ * @brief Read every ISO14443-A tag in the field
+ * @param tags Output array
+ * @param maxTags Capacity of tags
+ * @return Number of tags found
+ */
+uint8_t CR95HF::inventory(CR95HF_UIDResult* tags, uint8_t maxTags) {
+    uint8_t count = fieldReset() ? collectTags(ISO14443A_REQA, tags, maxTags) : 0;
+    logValue("[CR95HF] Inventory: %lu tag(s)\n", count);
+    return count;
+}
+
+/**
+ * @brief Resolve, select and halt tags one after the other
+ * @param wakeCmd First wake command: WUPA (all tags) or REQA (non-halted)
+ * @param tags Output array
+ * @param maxTags Capacity of tags
+ * @return Number of tags found
+ *
+ * After the first round only REQA is sent, which halted tags ignore.
+ */
+uint8_t CR95HF::collectTags(uint8_t wakeCmd, CR95HF_UIDResult* tags, uint8_t maxTags) {
+    uint8_t count = 0;
+    uint8_t failures = 0;
+
+    while (count < maxTags && failures < 3) {
+        uint8_t atqa1 = 0, atqa2 = 0;
+        if (!sendReqWup(wakeCmd, atqa1, atqa2)) break;
+        wakeCmd = ISO14443A_REQA;
+
+        CR95HF_UIDResult& tag = tags[count];
+        memset(&tag, 0, sizeof(tag));
+        tag.atqa[0] = lastATQA[0] = atqa1;
+        tag.atqa[1] = lastATQA[1] = atqa2;
+
+        if (!selectResolved(tag)) {
+            failures++;
+            continue;
+        }
+        halt();
+
+        // A tag that ignored HLTA answers again: don't list it twice
+        bool seen = false;
+        for (uint8_t i = 0; i < count && !seen; i++) {
+            seen = tags[i].uidLen == tag.uidLen &&
+                   memcmp(tags[i].uid, tag.uid, tag.uidLen) == 0;
+        }
+        if (seen) {
+            failures++;
+            continue;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+// ============================================================================
+// Tag Tracking
+// ============================================================================
+
+/**
+ * @brief Find tracking entry for a UID
+ * @param tag Tag to look up
+ * @return Entry, or NULL if not tracked
+ */
+CR95HF_TrackedTag* CR95HF::findTracked(const CR95HF_UIDResult& tag) {
+    for (uint8_t i = 0; i < CR95HF_TRACK_CAPACITY; i++) {
+        CR95HF_TrackedTag& t = _tracked[i];
+        if (t.used && t.tag.uidLen == tag.uidLen &&
+            memcmp(t.tag.uid, tag.uid, tag.uidLen) == 0) {
+            return &t;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Number of tags currently tracked
+ */
+uint8_t CR95HF::trackedCount() const {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < CR95HF_TRACK_CAPACITY; i++) {
+        if (_tracked[i].used) n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Run one tracking cycle
+ * @return Number of tags currently tracked
+ */
+uint8_t CR95HF::track() {
+    uint32_t now = millis();
+    uint8_t tracked = 0;
+
+    // Step 1: Confirm known tags (each ends halted)
+    for (uint8_t i = 0; i < CR95HF_TRACK_CAPACITY; i++) {
+        CR95HF_TrackedTag& t = _tracked[i];
+        if (!t.used) continue;
+
+        if (isStillPresent(t.tag.uid, t.tag.uidLen)) {
+            t.lastSeen = now;
+            t.misses = 0;
+            tracked++;
+            continue;
+        }
+
+        if (t.misses < 0xFF) t.misses++;
+        if (t.misses > _trackMisses && now - t.lastSeen >= _trackHoldOff) {
+            t.used = false;
+            if (_onLeave) _onLeave(t.tag);
+        } else {
+            tracked++;
+        }
+    }
+
+    // Step 2: Look for new tags. Known ones are halted, so REQA only wakes
+    // newcomers. With nothing tracked, a WUPA probe also sees tags halted
+    // elsewhere; a field reset then lets all of them be resolved in turn.
+    CR95HF_UIDResult found[CR95HF_TRACK_CAPACITY];
+    uint8_t n = 0;
+    if (tracked) {
+        n = collectTags(ISO14443A_REQA, found, CR95HF_TRACK_CAPACITY);
+    } else {
+        uint8_t atqa1, atqa2;
+        if (sendReqWup(ISO14443A_WUPA, atqa1, atqa2) && fieldReset()) {
+            n = collectTags(ISO14443A_REQA, found, CR95HF_TRACK_CAPACITY);
+        }
+    }
+
+    for (uint8_t i = 0; i < n; i++) {
+        CR95HF_TrackedTag* t = findTracked(found[i]);
+        if (t) {
+            // Known tag knocked back to IDLE by another tag's SELECT
+            t->lastSeen = now;
+            t->misses = 0;
+            continue;
+        }
+
+        for (uint8_t j = 0; j < CR95HF_TRACK_CAPACITY; j++) {
+            if (_tracked[j].used) continue;
+            _tracked[j].tag = found[i];
+            _tracked[j].lastSeen = now;
+            _tracked[j].misses = 0;
+            _tracked[j].used = true;
+            tracked++;
+            if (_onEnter) _onEnter(found[i]);
+            break;
+        }
+        // Cache full: tag ignored until a slot frees up
+    }
+
+    return tracked;
+}
+
+// ============================================================================
+// Raw RF Exchange
+// ============================================================================
+
+/**
+ * @brief SendRecv with CRC, response checked and left in _rfBuf
+ * @param hdr First RF bytes (PCB, command code, ...)
+ * @param hdrLen Number of header bytes
+ * @param body Further RF bytes (may be NULL)
+ * @param bodyLen Number of body bytes
+ * @param timeoutMs Host-side timeout
+ * @param rxLen Output: tag answer length in _rfBuf (CRC and status removed)
+ * @return true if the tag answered without CRC, parity or collision error
+ */
+bool CR95HF::rfExchange(const uint8_t* hdr, uint8_t hdrLen, const uint8_t* body, uint8_t bodyLen,
+                        uint32_t timeoutMs, uint8_t& rxLen) {
+    rxLen = 0;
+    uint16_t rfLen = hdrLen + bodyLen;
+    if (rfLen + 3u > sizeof(_rfBuf)) return false;
+
+    // Built in place: command, length, RF bytes, flags
+    _rfBuf[0] = CR95HF_CMD_SENDRECV;
+    _rfBuf[1] = rfLen + 1;
+    memcpy(&_rfBuf[2], hdr, hdrLen);
+    if (bodyLen) memcpy(&_rfBuf[2 + hdrLen], body, bodyLen);
+    _rfBuf[2 + rfLen] = CR95HF_FLAG_STD_CRC;
+    sendFrame(CR95HF_Bytes(_rfBuf, rfLen + 3));
+
+    uint8_t code, len = sizeof(_rfBuf);
+    if (!readResponse(code, _rfBuf, len, timeoutMs)) return false;
+    if (code != CR95HF_RSP_DATA || _rxLen > len) return false;  // Error or overflow
+    if (len < 2 + CR95HF_RX_TRAILER_LEN) return false;
+
+    uint8_t flags = _rfBuf[len - CR95HF_RX_TRAILER_LEN];
+    if (flags & (CR95HF_RXFLAG_COLLISION | CR95HF_RXFLAG_CRCERR | CR95HF_RXFLAG_PARITYERR)) {
+        return false;
+    }
+    rxLen = len - CR95HF_RX_TRAILER_LEN - 2;  // Drop CRC_A
+    return true;
+}
+
+/**
+ * @brief Raw RF exchange with the selected tag
+ * @param tx RF bytes (without CRC)
+ * @param txLen Number of bytes
+ * @param rx Output: tag answer
+ * @param rxLen Input: capacity, Output: answer length
+ * @param timeoutMs Host-side timeout
+ * @return true if the tag answered with a correct CRC
+ */
+bool CR95HF::transceive(const uint8_t* tx, uint8_t txLen, uint8_t* rx, uint8_t& rxLen,
+                        uint32_t timeoutMs) {
+    uint8_t cap = rxLen, n;
+    rxLen = 0;
+    if (!rfExchange(tx, txLen, NULL, 0, timeoutMs, n) || n > cap) return false;
+    memcpy(rx, _rfBuf, n);
+    rxLen = n;
+    return true;
+}
+
+// ============================================================================
+// ISO14443-4 (ISO-DEP)
+// ============================================================================
+
+/**
+ * @brief Reprogram ISO14443-A bit rates and CR95HF frame waiting time
+ * @param rates ProtocolSelect parameter (tx rate bits 7:6, rx rate bits 5:4)
+ * @param fwi Card frame waiting time integer
+ * @param fwtMult Waiting time extension multiplier (1 = none)
+ * @return true if the CR95HF accepted
+ *
+ * With PP = FWI, MM = 2 * mult - 1 and DD = 0 the CR95HF waits twice the
+ * card FWT (302 us * 2^FWI * mult). The RF field stays on.
+ */
+bool CR95HF::isoDepConfigure(uint8_t rates, uint8_t fwi, uint8_t fwtMult) {
+    _txFrame.buildProtocolSelect(CR95HF_PROTO_ISO14443A, rates, fwi, 2 * fwtMult - 1, 0);
+    sendFrame(_txFrame);
+
+    uint8_t code, buf[8], len = sizeof(buf);
+    if (!readResponse(code, buf, len) || code != CR95HF_RSP_SUCCESS) return false;
+    _isoConfigured = true;
+    return _arcB ? writeArcB(_arcB) : true;
+}
+
+/**
+ * @brief Host-side timeout of one ISO-DEP block exchange
+ * @param wtxm Waiting time extension multiplier (0 = none)
+ * @param txRf Block bytes sent (without CRC)
+ * @return Timeout in milliseconds
+ *
+ * Twice the card FWT plus the block and the largest answer the buffer
+ * holds, on air at 106 kbit/s and over the link.
+ */
+uint32_t CR95HF::isoDepTimeout(uint8_t wtxm, uint16_t txRf) const {
+    uint32_t fwtUs = (302UL << _isoFwi) * (wtxm ? wtxm : 1);
+    uint16_t rxRf = sizeof(_rfBuf) - CR95HF_RX_TRAILER_LEN;
+    return (2 * fwtUs) / 1000 +
+           rfTimeout(txRf, rxRf, CR95HF_RF_BYTE_US_A, CR95HF_RF_FRAME_US_A);
+}
+
+/**
+ * @brief Time to move bytes over the host link
+ * @param bytes Number of bytes
+ * @return Milliseconds at the current baud rate (8N2), at least 1
+ */
+uint32_t CR95HF::linkMs(uint16_t bytes) const {
+    uint32_t baud = _link->baudRate();
+    return baud ? (uint32_t)bytes * 11 * 1000 / baud + 1 : 1;
+}
+
+/**
+ * @brief Host-side timeout of an RF exchange with a known answer length
+ * @param txRf RF bytes sent (without CRC)
+ * @param rxRf RF bytes answered (with CRC)
+ * @param byteUs Air time per byte (CR95HF_RF_BYTE_US_*)
+ * @param frameUs Air time per frame (CR95HF_RF_FRAME_US_*)
+ * @return Milliseconds
+ *
+ * The CR95HF starts its reply only once the whole tag frame is in, so the
+ * air time of both frames comes on top of command and reply over the link.
+ */
+uint32_t CR95HF::rfTimeout(uint16_t txRf, uint16_t rxRf, uint16_t byteUs, uint16_t frameUs) const {
+    uint32_t airUs = (uint32_t)(txRf + 2 + rxRf) * byteUs + 2UL * frameUs;
+    uint32_t wire = linkMs(txRf + 3 + 2 + rxRf + CR95HF_RX_TRAILER_LEN);
+    return wire + (airUs + 999) / 1000 + CR95HF_TMO_MARGIN_MS;
+}
+
+/**
+ * @brief Host-side timeout of the reply to an Idle command
+ * @param sleepCycles LFO periods slept before the wake-up (0 = IRQ_IN)
+ * @return Milliseconds
+ *
+ * The sleep, the oscillator and DAC start-up delays, then the wake-up
+ * source over the link.
+ */
+uint32_t CR95HF::idleTimeout(uint32_t sleepCycles) const {
+    uint32_t us = (sleepCycles + CR95HF_IDLE_OSC_START + CR95HF_IDLE_DAC_START) *
+                  CR95HF_IDLE_LFO_US;
+    return (us + 999) / 1000 + linkMs(_txLen + 2 + 1) + CR95HF_TMO_MARGIN_MS;
+}
+
+/**
+ * @brief Close the ISO-DEP session, back to default ISO14443-A settings
+ */
+void CR95HF::isoDepReset() {
+    _isoActive = false;
+    if (_isoConfigured) selectProtocol(CR95HF_PROTO_ISO14443A);
+}
+
+/**
+ * @brief Enter ISO-DEP on the selected tag
+ * @param ats Output: parsed ATS (may be NULL)
+ * @param highSpeed Negotiate a higher bit rate with PPS
+ * @return true if the card answered RATS
+ */
+bool CR95HF::isoDepActivate(CR95HF_ATS* ats, bool highSpeed) {
+    static const uint16_t frameSizes[] = {16, 24, 32, 40, 48, 64, 96, 128, 256};
+    _isoActive = false;
+
+    // Largest frame (FSD) the receive buffer holds with its status bytes
+    uint8_t fsdi = 0;
+    while (fsdi < 8 && frameSizes[fsdi + 1] <= sizeof(_rfBuf) - CR95HF_RX_TRAILER_LEN) fsdi++;
+
+    // Activation frame waiting time is FWI 4 (~4.8 ms)
+    _isoFwi = 4;
+    _isoRates = 0;
+    if (!isoDepConfigure(0, _isoFwi, 1)) return false;
+
+    uint8_t rats[2] = {ISO14443_4_RATS, (uint8_t)(fsdi << 4)};  // CID 0
+    uint8_t n;
+    if (!rfExchange(rats, sizeof(rats), NULL, 0, isoDepTimeout(0, sizeof(rats)), n) || n < 1) {
+        log("[ISO-DEP] No ATS\n");
+        isoDepReset();
+        return false;
+    }
+
+    // ATS: TL T0 [TA] [TB] [TC] historical bytes; defaults when absent
+    CR95HF_ATS a;
+    memset(&a, 0, sizeof(a));
+    a.len = (n < CR95HF_ATS_MAX) ? n : CR95HF_ATS_MAX;
+    memcpy(a.data, _rfBuf, a.len);
+    a.fsc = 32;
+    a.fwi = 4;
+    uint8_t pos = 1;
+    if (n > 1) {
+        uint8_t t0 = _rfBuf[pos++];
+        a.fsc = frameSizes[((t0 & 0x0F) < 8) ? (t0 & 0x0F) : 8];
+        if ((t0 & 0x10) && pos < n) a.ta = _rfBuf[pos++];
+        if ((t0 & 0x20) && pos < n) {
+            a.fwi = _rfBuf[pos] >> 4;
+            a.sfgi = _rfBuf[pos] & 0x0F;
+            pos++;
+        }
+        if ((t0 & 0x40) && pos < n) pos++;  // TC: NAD / CID support (not used)
+    }
+    if (a.fwi > 14) a.fwi = 4;      // 15 is RFU
+    if (a.sfgi > 14) a.sfgi = 0;
+    a.histOffset = pos;
+    if (ats) *ats = a;
+
+    // Card needs SFGT before the next frame
+    if (a.sfgi) delay((302UL << a.sfgi) / 1000 + 1);
+
+    _isoFsc = a.fsc;
+    _isoFwi = a.fwi;
+    _isoBlockNum = 0;
+    _isoActive = true;
+    logValue("[ISO-DEP] Active, FSC %lu\n", _isoFsc);
+
+    // PPS: fastest rate in TA(1) up to 424 kbps (b8 set: same rate both ways)
+    bool switched = false;
+    if (highSpeed && a.ta) {
+        uint8_t ds = (a.ta >> 4) & 0x03, dr = a.ta & 0x03;     // bit 0: 212, bit 1: 424
+        uint8_t dsi = (ds & 0x02) ? 2 : (ds & 0x01) ? 1 : 0;
+        uint8_t dri = (dr & 0x02) ? 2 : (dr & 0x01) ? 1 : 0;
+        if (a.ta & 0x80) dsi = dri = (dsi < dri) ? dsi : dri;
+        if (dsi || dri) switched = isoDepPPS(dsi, dri);  // Failure keeps 106 kbps
+    }
+
+    // Card waiting time (isoDepPPS() already applied it)
+    if (!switched && _isoFwi != 4) isoDepConfigure(_isoRates, _isoFwi, 1);
+    return true;
+}
+
+/**
+ * @brief Change bit rates with PPS
+ * @param dsi Card to reader divisor integer (0-2)
+ * @param dri Reader to card divisor integer (0-2)
+ * @return true if switched
+ */
+bool CR95HF::isoDepPPS(uint8_t dsi, uint8_t dri) {
+    if (!_isoActive || dsi > 2 || dri > 2) return false;
+
+    uint8_t pps[3] = {ISO14443_4_PPS, 0x11, (uint8_t)((dsi << 2) | dri)};
+    uint8_t n;
+    if (!rfExchange(pps, sizeof(pps), NULL, 0, isoDepTimeout(0, sizeof(pps)), n) || n < 1 ||
+        _rfBuf[0] != ISO14443_4_PPS) {
+        log("[ISO-DEP] PPS failed\n");
+        return false;
+    }
+
+    // CR95HF: transmit rate = DRI, receive rate = DSI
+    uint8_t rates = (dri << 6) | (dsi << 4);
+    if (!isoDepConfigure(rates, _isoFwi, 1)) return false;
+    _isoRates = rates;
+    return true;
+}
+
+/**
+ * @brief Exchange an APDU with the ISO-DEP card
+ * @param cmd Command APDU
+ * @param cmdLen Command length
+ * @param resp Output: response APDU
+ * @param respLen Input: capacity, Output: response length
+ * @return true on success
+ *
+ * Block rules (ISO14443-4 7.5.4): a failed exchange is answered with
+ * R(NAK); an R(ACK) carrying the other block number means the card missed
+ * our last block, which is sent again. An I-block carrying the other block
+ * number repeats one already taken and is dropped. S(WTX) is confirmed and
+ * the next wait extended by its multiplier.
+ */
+bool CR95HF::transceiveAPDU(const uint8_t* cmd, uint16_t cmdLen, uint8_t* resp, uint16_t& respLen) {
+    uint16_t cap = respLen;
+    respLen = 0;
+    if (!_isoActive) return false;
+
+    // INF bytes per I-block: FSC minus PCB and CRC, capped by the buffer
+    uint16_t infMax = _isoFsc - 3;
+    if (infMax > sizeof(_rfBuf) - 4) infMax = sizeof(_rfBuf) - 4;
+
+    uint16_t sent = 0;              // Command bytes acknowledged by the card
+    uint16_t chunk = (cmdLen < infMax) ? cmdLen : infMax;
+    uint8_t ctl[2];                 // Last R(ACK) / S(WTX) sent, ctlLen 0 = I-block
+    uint8_t ctlLen = 0;
+    bool nak = false;               // Send R(NAK) instead of the last block
+    uint8_t retries = 0;
+    uint8_t wtxm = 0;
+
+    for (;;) {
+        uint8_t n;
+        bool ok;
+        if (nak) {
+            uint8_t r = ISO14443_4_PCB_R_NAK | _isoBlockNum;
+            ok = rfExchange(&r, 1, NULL, 0, isoDepTimeout(wtxm, 1), n);
+        } else if (ctlLen) {
+            ok = rfExchange(ctl, ctlLen, NULL, 0, isoDepTimeout(wtxm, ctlLen), n);
+        } else {
+            uint8_t pcb = ISO14443_4_PCB_I | _isoBlockNum |
+                          ((sent + chunk < cmdLen) ? ISO14443_4_PCB_CHAIN : 0);
+            ok = rfExchange(&pcb, 1, &cmd[sent], chunk, isoDepTimeout(wtxm, 1 + chunk), n);
+        }
+        if (wtxm) {
+            wtxm = 0;
+            isoDepConfigure(_isoRates, _isoFwi, 1);  // Extension covers one exchange
+        }
+
+        if (!ok || n < 1) {
+            if (++retries > CR95HF_ISO_RETRIES) break;
+            nak = true;
+            continue;
+        }
+        nak = false;
+
+        uint8_t pcb = _rfBuf[0];
+        if ((pcb & 0xE2) == ISO14443_4_PCB_I) {
+            // I-block: (part of) the response, only valid after our last block
+            if (sent + chunk < cmdLen) break;
+            if ((pcb & 0x01) != _isoBlockNum) {
+                if (++retries > CR95HF_ISO_RETRIES) break;
+                continue;  // Block already taken: ask again for the next one
+            }
+            if (respLen + n - 1 > cap) break;
+            memcpy(&resp[respLen], &_rfBuf[1], n - 1);
+            respLen += n - 1;
+            _isoBlockNum ^= 1;
+            retries = 0;
+            if (!(pcb & ISO14443_4_PCB_CHAIN)) return true;
+            ctl[0] = ISO14443_4_PCB_R_ACK | _isoBlockNum;
+            ctlLen = 1;
+        } else if ((pcb & 0xF6) == ISO14443_4_PCB_R_ACK) {
+            if ((pcb & 0x01) != _isoBlockNum) {
+                if (++retries > CR95HF_ISO_RETRIES) break;
+                continue;  // Card missed our last block: repeat it
+            }
+            // Chained I-block acknowledged: next part of the command
+            if (sent + chunk >= cmdLen) break;
+            _isoBlockNum ^= 1;
+            ctlLen = 0;
+            retries = 0;
+            sent += chunk;
+            chunk = (cmdLen - sent < infMax) ? cmdLen - sent : infMax;
+        } else if ((pcb & 0xF7) == ISO14443_4_PCB_WTX && n >= 2) {
+            wtxm = _rfBuf[1] & 0x3F;
+            if (wtxm == 0 || wtxm > 59) wtxm = 59;  // 0 and > 59 are RFU
+            isoDepConfigure(_isoRates, _isoFwi, wtxm);
+            ctl[0] = ISO14443_4_PCB_WTX;
+            ctl[1] = wtxm;
+            ctlLen = 2;
+        } else {
+            break;
+        }
+    }
+
+    log("[ISO-DEP] APDU exchange failed\n");
+    respLen = 0;
+    isoDepReset();
+    return false;
+}
+
+/**
+ * @brief Leave ISO-DEP with S(DESELECT)
+ * @return true if the card confirmed
+ */
+bool CR95HF::isoDepDeselect() {
+    if (!_isoActive) return false;
+
+    uint8_t s = ISO14443_4_PCB_DESELECT, n;
+    bool ok = rfExchange(&s, 1, NULL, 0, isoDepTimeout(0, 1), n) && n >= 1 &&
+              _rfBuf[0] == ISO14443_4_PCB_DESELECT;
+    _tagHalted = ok;  // Deselected card waits in HALT
+    isoDepReset();
+    return ok;
+}
+
+// ============================================================================
+// NTAG / Ultralight Memory
+// ============================================================================
+
+/**
+ * @brief Page cache of the selected tag (claims the LRU entry for a new UID)
+ * @return Entry, or NULL if no tag is selected
+ */
+CR95HF_PageCache* CR95HF::pageCacheEntry() {
+    if (_selUidLen == 0) return NULL;
+
+    CR95HF_PageCache* lru = &_pageCache[0];
+    for (uint8_t i = 0; i < CR95HF_NTAG_CACHE_TAGS; i++) {
+        CR95HF_PageCache& c = _pageCache[i];
+        if (c.uidLen == _selUidLen && memcmp(c.uid, _selUid, _selUidLen) == 0) {
+            c.used = millis();
+            return &c;
+        }
+        if (c.uidLen == 0 || (lru->uidLen != 0 && (int32_t)(c.used - lru->used) < 0)) lru = &c;
+    }
+
+    memcpy(lru->uid, _selUid, _selUidLen);
+    lru->uidLen = _selUidLen;
+    lru->fastRead = true;
+    lru->valid = 0;
+    lru->used = millis();
+    return lru;
+}
+
+/**
+ * @brief Read pages over RF into the cache and a byte window of the caller
+ * @param c Cache entry of the selected tag
+ * @param page First page
+ * @param count Number of pages
+ * @param offset Byte address of out[0]
+ * @param out Caller buffer (bytes outside [offset, offset + n) are not kept)
+ * @param n Caller buffer length
+ * @return true if every page was read
+ */
+bool CR95HF::ntagFetch(CR95HF_PageCache& c, uint8_t page, uint8_t count,
+                       uint16_t offset, uint8_t* out, uint16_t n) {
+    // Pages per FAST_READ: data + CRC + status bytes must fit the buffer
+    const uint8_t maxPages = (CR95HF_RF_BUFFER - 2 - CR95HF_RX_TRAILER_LEN) / NTAG_PAGE_SIZE;
+
+    while (count) {
+        uint8_t pages = (count < maxPages) ? count : maxPages;
+        uint8_t got = 0;
+        bool ok = false;
+        bool fast = c.fastRead;
+
+        if (fast) {
+            uint8_t cmd[3] = {NTAG_CMD_FAST_READ, page, (uint8_t)(page + pages - 1)};
+            uint32_t tmo = rfTimeout(sizeof(cmd), pages * NTAG_PAGE_SIZE + 2,
+                                     CR95HF_RF_BYTE_US_A, CR95HF_RF_FRAME_US_A);
+            ok = rfExchange(cmd, sizeof(cmd), NULL, 0, tmo, got) &&
+                 got == pages * NTAG_PAGE_SIZE;
+            if (!ok) {
+                if (_rxPhase != RX_DONE) {
+                    // Reply late: let it finish so the link stays in sync,
+                    // READ this chunk but keep FAST_READ for the next one
+                    drainRx(tmo);
+                } else if (_rxCode == CR95HF_RSP_DATA && _rxCount < 2 + CR95HF_RX_TRAILER_LEN) {
+                    // NAK: not supported
+                    c.fastRead = false;
+                    log("[NTAG] FAST_READ refused, using READ\n");
+                }
+                // IDLE after a NAK, unknown after a broken exchange
+                if (!selectKnown(c.uid, c.uidLen)) return false;
+                fast = false;
+            }
+        }
+        if (!fast) {
+            if (pages > 4) pages = 4;
+            uint8_t cmd[2] = {NTAG_CMD_READ, page};
+            ok = rfExchange(cmd, sizeof(cmd), NULL, 0,
+                            rfTimeout(sizeof(cmd), 16 + 2, CR95HF_RF_BYTE_US_A, CR95HF_RF_FRAME_US_A),
+                            got) && got == 16;
+        }
+        if (!ok) return false;
+
+        // Keep cacheable pages, copy the part the caller asked for
+        for (uint8_t i = 0; i < pages; i++) {
+            uint16_t p = page + i;
+            if (p < CR95HF_NTAG_CACHE_PAGES) {
+                memcpy(&c.data[p * NTAG_PAGE_SIZE], &_rfBuf[i * NTAG_PAGE_SIZE], NTAG_PAGE_SIZE);
+                c.valid |= (1UL << p);
+            }
+        }
+        uint16_t from = page * NTAG_PAGE_SIZE, to = from + pages * NTAG_PAGE_SIZE;
+        if (from < offset) from = offset;
+        if (to > offset + n) to = offset + n;
+        if (from < to) memcpy(&out[from - offset], &_rfBuf[from - page * NTAG_PAGE_SIZE], to - from);
+
+        page += pages;
+        count -= pages;
+    }
+    return true;
+}
+
+/**
+ * @brief Read a byte range of tag memory, cache first
+ * @param offset Byte address (page * 4 + byte)
+ * @param out Output buffer
+ * @param n Number of bytes
+ * @return true if read
+ *
+ * A miss inside the cached area reads ahead to the end of it, so the CC
+ * and the first TLVs arrive in one FAST_READ.
+ */
+bool CR95HF::ntagReadBytes(uint16_t offset, uint8_t* out, uint16_t n) {
+    CR95HF_PageCache* c = pageCacheEntry();
+    if (!c) return false;
+
+    uint16_t end = offset + n;
+    uint16_t pos = offset;
+    while (pos < end) {
+        uint16_t p = pos / NTAG_PAGE_SIZE;
+        if (p < CR95HF_NTAG_CACHE_PAGES && (c->valid & (1UL << p))) {
+            uint16_t take = (p + 1) * NTAG_PAGE_SIZE;
+            if (take > end) take = end;
+            memcpy(&out[pos - offset], &c->data[pos], take - pos);
+            pos = take;
+            continue;
+        }
+
+        // Run of missing pages up to the next cached one
+        uint16_t last = (end - 1) / NTAG_PAGE_SIZE;
+        if (last < CR95HF_NTAG_CACHE_PAGES - 1) last = CR95HF_NTAG_CACHE_PAGES - 1;
+        uint16_t q = p;
+        while (q < last && !(q + 1 < CR95HF_NTAG_CACHE_PAGES && (c->valid & (1UL << (q + 1))))) q++;
+        if (q > 255) q = 255;
+
+        if (!ntagFetch(*c, p, q - p + 1, offset, out, n)) return false;
+        pos = (q + 1) * NTAG_PAGE_SIZE;
+    }
+    return true;
+}
+
+/**
+ * @brief Read NTAG / Ultralight pages
+ * @param page First page
+ * @param count Number of pages
+ * @param out Output: count * 4 bytes
+ * @return true if read
+ */
+bool CR95HF::ntagReadPages(uint8_t page, uint8_t count, uint8_t* out) {
+    return ntagReadBytes(page * NTAG_PAGE_SIZE, out, count * NTAG_PAGE_SIZE);
+}
+
+/**
+ * @brief Read the NDEF message of the selected Type 2 tag
+ * @param msg Output: NDEF message
+ * @param msgLen Input: capacity, Output: message length
+ * @return true if read
+ */
+bool CR95HF::ntagReadNdef(uint8_t* msg, uint16_t& msgLen) {
+    uint16_t cap = msgLen;
+    msgLen = 0;
+
+    uint8_t cc[NTAG_PAGE_SIZE];
+    if (!ntagReadBytes(NTAG_PAGE_CC * NTAG_PAGE_SIZE, cc, sizeof(cc))) return false;
+    if (cc[0] != NDEF_CC_MAGIC) return false;
+
+    // Walk TLVs through the data area (CC byte 2: size / 8)
+    uint16_t pos = NTAG_PAGE_DATA * NTAG_PAGE_SIZE;
+    uint16_t end = pos + cc[2] * 8;
+    while (pos < end) {
+        uint8_t t;
+        if (!ntagReadBytes(pos++, &t, 1)) return false;
+        if (t == NDEF_TLV_NULL) continue;
+        if (t == NDEF_TLV_TERMINATOR) break;
+
+        // Length: 1 byte, or 0xFF + 2 bytes big-endian
+        uint8_t l[3];
+        if (!ntagReadBytes(pos++, l, 1)) return false;
+        uint16_t len = l[0];
+        if (len == 0xFF) {
+            if (!ntagReadBytes(pos, &l[1], 2)) return false;
+            len = (l[1] << 8) | l[2];
+            pos += 2;
+        }
+
+        if (t == NDEF_TLV_MESSAGE) {
+            if (pos + len > end) return false;
+            msgLen = len;
+            if (len > cap) return false;
+            if (!ntagReadBytes(pos, msg, len)) {
+                msgLen = 0;
+                return false;
+            }
+            return true;  // Nothing past the message is read
+        }
+        pos += len;  // Lock / memory control or proprietary TLV
+    }
+    return false;
+}
+
+// ============================================================================
+// Tag Identification
+// ============================================================================
+
+/**
+ * @brief Identify the selected tag (cached per UID)
+ * @param info Output
+ * @return false if no tag is selected
+ */
+bool CR95HF::identify(CR95HF_TagInfo& info) {
+    memset(&info, 0, sizeof(info));
+    if (_selUidLen == 0) return false;
+
+    IdentEntry* lru = &_ident[0];
+    for (uint8_t i = 0; i < CR95HF_IDENT_CACHE; i++) {
+        IdentEntry& e = _ident[i];
+        if (e.uidLen == _selUidLen && memcmp(e.uid, _selUid, _selUidLen) == 0) {
+            e.used = millis();
+            info = e.info;
+            return true;
+        }
+        if (e.uidLen == 0 || (lru->uidLen != 0 && (int32_t)(e.used - lru->used) < 0)) lru = &e;
+    }
+
+    // Probes may reselect the tag: keep the key
+    uint8_t uid[10], uidLen = _selUidLen;
+    memcpy(uid, _selUid, uidLen);
+
+    switch (_selSak) {
+        case SAK_MIFARE_UL:
+            identifyType2(info);
+            break;
+        case SAK_MIFARE_MINI:
+            info.model = CR95HF_MODEL_CLASSIC_MINI;
+            info.memorySize = 320;
+            break;
+        case SAK_MIFARE_1K:
+            info.model = CR95HF_MODEL_CLASSIC_1K;
+            info.memorySize = 1024;
+            break;
+        case SAK_MIFARE_4K:
+            info.model = CR95HF_MODEL_CLASSIC_4K;
+            info.memorySize = 4096;
+            break;
+        default:
+            if (_selSak & 0x20) identifyIsoDep(info);
+            break;
+    }
+
+    memcpy(lru->uid, uid, uidLen);
+    lru->uidLen = uidLen;
+    lru->used = millis();
+    lru->info = info;
+    logValue("[CR95HF] Model: %lu\n", info.model);
+    return true;
+}
+
+/**
+ * @brief Identify a SAK 0x00 tag with GET_VERSION
+ * @param info Output
+ */
+void CR95HF::identifyType2(CR95HF_TagInfo& info) {
+    uint8_t cmd = NTAG_CMD_GET_VERSION, n;
+    uint32_t tmo = rfTimeout(1, 8 + 2, CR95HF_RF_BYTE_US_A, CR95HF_RF_FRAME_US_A);
+    if (rfExchange(&cmd, 1, NULL, 0, tmo, n) && n == 8) {
+        // 00 vendor type subtype major minor storage protocol
+        memcpy(info.version, _rfBuf, 8);
+        info.versionLen = 8;
+        uint8_t type = _rfBuf[2], subtype = _rfBuf[3], major = _rfBuf[4], storage = _rfBuf[6];
+
+        info.model = CR95HF_MODEL_TYPE2;
+        info.memorySize = 1 << (storage >> 1);  // Lower bound when bit 0 is set
+        if (_rfBuf[1] != 0x04) return;          // Not NXP
+
+        if (type == 0x04 && subtype == 0x05) {
+            if (storage == 0x13) { info.model = CR95HF_MODEL_NTAG_I2C_1K; info.memorySize = 888; }
+            if (storage == 0x15) { info.model = CR95HF_MODEL_NTAG_I2C_2K; info.memorySize = 1904; }
+        } else if (type == 0x04) {
+            switch (storage) {
+                case 0x0B: info.model = CR95HF_MODEL_NTAG210; info.memorySize = 48; break;
+                case 0x0E: info.model = CR95HF_MODEL_NTAG212; info.memorySize = 128; break;
+                case 0x0F: info.model = CR95HF_MODEL_NTAG213; info.memorySize = 144; break;
+                case 0x11: info.model = CR95HF_MODEL_NTAG215; info.memorySize = 504; break;
+                case 0x13: info.model = CR95HF_MODEL_NTAG216; info.memorySize = 888; break;
+            }
+        } else if (type == 0x03 && major == 0x01) {
+            if (storage == 0x0B) { info.model = CR95HF_MODEL_ULTRALIGHT_EV1_48; info.memorySize = 48; }
+            if (storage == 0x0E) { info.model = CR95HF_MODEL_ULTRALIGHT_EV1_128; info.memorySize = 128; }
+        }
+        return;
+    }
+
+    // No GET_VERSION: Ultralight or Ultralight C. The NAK sent the tag to
+    // IDLE; Ultralight C answers AUTHENTICATE part 1 with AF + 8 bytes.
+    uint8_t uid[10], uidLen = _selUidLen;
+    memcpy(uid, _selUid, uidLen);
+    if (!selectKnown(uid, uidLen)) return;
+
+    uint8_t auth[2] = {ULC_CMD_AUTH, 0x00};
+    tmo = rfTimeout(sizeof(auth), 1 + 8 + 2, CR95HF_RF_BYTE_US_A, CR95HF_RF_FRAME_US_A);
+    bool ulc = rfExchange(auth, sizeof(auth), NULL, 0, tmo, n) && n == 9 && _rfBuf[0] == 0xAF;
+    info.model = ulc ? CR95HF_MODEL_ULTRALIGHT_C : CR95HF_MODEL_ULTRALIGHT;
+    info.memorySize = ulc ? 144 : 48;
+
+    selectKnown(uid, uidLen);  // Leave it ACTIVE, no authentication pending
+}
 
-    // Step 3: Select ISO14443A protocol
-    if (!protocolSelectA()) {
-        log("[CR95HF] Protocol select failed\n");
-        return false;
+/**
+ * @brief Identify an ISO14443-4 card from its DESFire version
+ * @param info Output
+ *
+ * Leaves the ISO-DEP session open for transceiveAPDU().
+ */
+void CR95HF::identifyIsoDep(CR95HF_TagInfo& info) {
+    if (!isoDepActivate()) return;
+    info.model = CR95HF_MODEL_ISO_DEP;
+
+    // Native GetVersion wrapped in ISO7816-4; first frame: hardware info
+    static const uint8_t getVersion[] = {0x90, NTAG_CMD_GET_VERSION, 0x00, 0x00, 0x00};
+    uint8_t resp[16];
+    uint16_t respLen = sizeof(resp);
+    if (!transceiveAPDU(getVersion, sizeof(getVersion), resp, respLen)) return;
+    if (respLen != 9 || resp[7] != 0x91 || resp[8] != 0xAF) return;
+    if (resp[0] != 0x04 || resp[1] != 0x01) return;  // NXP DESFire
+
+    memcpy(info.version, resp, 7);
+    info.versionLen = 7;
+    info.memorySize = 1 << (resp[5] >> 1);
+    switch (resp[3]) {
+        case 0x00: info.model = CR95HF_MODEL_DESFIRE; break;
+        case 0x01: info.model = CR95HF_MODEL_DESFIRE_EV1; break;
+        case 0x12: info.model = CR95HF_MODEL_DESFIRE_EV2; break;
+        case 0x33: info.model = CR95HF_MODEL_DESFIRE_EV3; break;
     }
-    log("[CR95HF] ISO14443A ready\n");
+}
 
-    return true;
+#if CR95HF_FEATURE_NAMES
+/**
+ * @brief Get model name string
+ * @param model CR95HF_TagModel
+ * @return Name
+ */
+const char* CR95HF::getModelName(uint8_t model) {
+    switch (model) {
+        case CR95HF_MODEL_TYPE2:             return "Type 2 tag";
+        case CR95HF_MODEL_ULTRALIGHT:        return "MIFARE Ultralight";
+        case CR95HF_MODEL_ULTRALIGHT_C:      return "MIFARE Ultralight C";
+        case CR95HF_MODEL_ULTRALIGHT_EV1_48: return "MIFARE Ultralight EV1 (48 bytes)";
+        case CR95HF_MODEL_ULTRALIGHT_EV1_128:return "MIFARE Ultralight EV1 (128 bytes)";
+        case CR95HF_MODEL_NTAG210:           return "NTAG210";
+        case CR95HF_MODEL_NTAG212:           return "NTAG212";
+        case CR95HF_MODEL_NTAG213:           return "NTAG213";
+        case CR95HF_MODEL_NTAG215:           return "NTAG215";
+        case CR95HF_MODEL_NTAG216:           return "NTAG216";
+        case CR95HF_MODEL_NTAG_I2C_1K:       return "NTAG I2C 1k";
+        case CR95HF_MODEL_NTAG_I2C_2K:       return "NTAG I2C 2k";
+        case CR95HF_MODEL_CLASSIC_MINI:      return "MIFARE Classic Mini";
+        case CR95HF_MODEL_CLASSIC_1K:        return "MIFARE Classic 1K";
+        case CR95HF_MODEL_CLASSIC_4K:        return "MIFARE Classic 4K";
+        case CR95HF_MODEL_DESFIRE:           return "MIFARE DESFire";
+        case CR95HF_MODEL_DESFIRE_EV1:       return "MIFARE DESFire EV1";
+        case CR95HF_MODEL_DESFIRE_EV2:       return "MIFARE DESFire EV2";
+        case CR95HF_MODEL_DESFIRE_EV3:       return "MIFARE DESFire EV3";
+        case CR95HF_MODEL_ISO_DEP:           return "ISO14443-4 card";
+        default:                             return "Unknown";
+    }
 }
+#endif // CR95HF_FEATURE_NAMES
 
+#if CR95HF_FEATURE_STATUS1
 // ============================================================================
-// Protocol Selection
+// ISO15693 (Vicinity)
 // ============================================================================
 
 /**
- * @brief Select ISO14443-A protocol
- * @return true if protocol selected successfully
+ * @brief SendRecv for ISO15693, ISO14443-B and FeliCa (1 status byte)
+ * @param req Request bytes (without CRC), none = ISO15693 EOF (next slot)
+ * @param reqLen Number of request bytes
+ * @param rxRf Longest tag answer expected (with CRC), sizes the timeout
+ * @param rxLen Output: tag answer length in _rfBuf (CRC and status removed)
+ * @param collision Output: something answered but not cleanly
+ * @return true if one tag answered without error
  */
-bool CR95HF::protocolSelectA() {
-    _txFrame.buildProtocolSelect(CR95HF_PROTO_ISO14443A, 0x00);
-    sendFrame(_txFrame);
+bool CR95HF::rfRequest(const uint8_t* req, uint8_t reqLen, uint8_t rxRf, uint8_t& rxLen,
+                       bool& collision) {
+    rxLen = 0;
+    collision = false;
+    if (reqLen + 2u > sizeof(_rfBuf)) return false;
+
+    // Both frames on air at the protocol's data rate, then over the link
+    uint32_t timeoutMs;
+    if (_proto == CR95HF_PROTO_ISO15693) {
+        timeoutMs = rfTimeout(reqLen, rxRf, CR95HF_RF_BYTE_US_15693, CR95HF_RF_FRAME_US_15693);
+    } else if (_proto == CR95HF_PROTO_ISO14443B) {
+        timeoutMs = rfTimeout(reqLen, rxRf, CR95HF_RF_BYTE_US_B, CR95HF_RF_FRAME_US_B);
+    } else {
+        timeoutMs = rfTimeout(reqLen, rxRf, CR95HF_RF_BYTE_US_F, CR95HF_RF_FRAME_US_F);
+    }
 
-    uint8_t code, buf[8], len = sizeof(buf);
-    if (!readResponse(code, buf, len, 50)) return false;
-    return code == CR95HF_RSP_SUCCESS;
+    fieldGuard();
+    _rfBuf[0] = CR95HF_CMD_SENDRECV;
+    _rfBuf[1] = reqLen;
+    if (reqLen) memcpy(&_rfBuf[2], req, reqLen);
+    sendFrame(CR95HF_Bytes(_rfBuf, reqLen + 2));
+
+    uint8_t code, len = sizeof(_rfBuf);
+    if (!readResponse(code, _rfBuf, len, timeoutMs)) return false;
+    if (code == CR95HF_RSP_TIMEOUT) return false;  // Nobody answered
+
+    // Tags answering together garble the frame: the CR95HF reports an RF
+    // error or a bad CRC rather than a collision position
+    collision = true;
+    if (code != CR95HF_RSP_DATA || _rxLen > len) return false;
+    if (len < 2 + CR95HF_RX15_TRAILER_LEN) return false;
+    if (_rfBuf[len - 1] & (CR95HF_RX15_COLLISION | CR95HF_RX15_CRCERR)) return false;
+
+    collision = false;
+    rxLen = len - CR95HF_RX15_TRAILER_LEN - 2;  // Drop CRC
+    return true;
 }
+#endif // CR95HF_FEATURE_STATUS1
 
-// ============================================================================
-// REQA / WUPA - Tag Wake Commands
-// ============================================================================
+#if CR95HF_FEATURE_ISO15693
 
 /**
- * @brief Send REQA or WUPA command
- * @param cmd Command (ISO14443A_REQA or ISO14443A_WUPA)
- * @param atqa1 Output: ATQA byte 1
- * @param atqa2 Output: ATQA byte 2
- * @return true if tag responded
+ * @brief One 16-slot inventory round, then one per collided slot
+ * @param mask UID bits already fixed (LSB first)
+ * @param maskBits Number of fixed bits (multiple of 4)
+ * @param tags Output array
+ * @param maxTags Array capacity
+ * @param found In/out: tags in the array
  */
-bool CR95HF::sendReqWup(uint8_t cmd, uint8_t& atqa1, uint8_t& atqa2) {
-    if (cmd == ISO14443A_WUPA) {
-        _txFrame.buildWUPA();
-    } else {
-        _txFrame.buildREQA();
+void CR95HF::iso15693Round(const uint8_t* mask, uint8_t maskBits, CR95HF_VicinityTag* tags,
+                           uint8_t maxTags, uint8_t& found) {
+    uint8_t maskBytes = (maskBits + 7) / 8;
+    uint8_t req[3 + ISO15693_UID_LEN] = {ISO15693_FLAG_HIGH_RATE | ISO15693_FLAG_INVENTORY,
+                                         ISO15693_CMD_INVENTORY, maskBits};
+    memcpy(&req[3], mask, maskBytes);
+
+    uint16_t collided = 0;
+    for (uint8_t slot = 0; slot < ISO15693_SLOTS && found < maxTags; slot++) {
+        // Slot 0 starts with the request, every further slot with an EOF
+        uint8_t n;
+        bool collision;
+        bool ok = rfRequest(req, slot ? 0 : 3 + maskBytes, ISO15693_INVENTORY_RSP_LEN, n, collision);
+
+        if (ok && n >= 2 + ISO15693_UID_LEN && !(_rfBuf[0] & ISO15693_FLAG_ERROR)) {
+            bool known = false;
+            for (uint8_t i = 0; i < found && !known; i++) {
+                known = memcmp(tags[i].uid, &_rfBuf[2], ISO15693_UID_LEN) == 0;
+            }
+            if (!known) {
+                tags[found].dsfid = _rfBuf[1];
+                memcpy(tags[found].uid, &_rfBuf[2], ISO15693_UID_LEN);
+                found++;
+            }
+        } else if (collision) {
+            collided |= 1 << slot;
+        }
     }
-    sendFrame(_txFrame);
 
-    uint8_t code, buf[16], len = sizeof(buf);
-    if (!readResponse(code, buf, len, 20)) return false;
+    // Split each collided slot on the next 4 UID bits
+    if (maskBits + 4 > ISO15693_UID_LEN * 8) return;
+    for (uint8_t slot = 0; slot < ISO15693_SLOTS && found < maxTags; slot++) {
+        if (!(collided & (1 << slot))) continue;
+
+        uint8_t sub[ISO15693_UID_LEN] = {0};
+        memcpy(sub, mask, maskBytes);
+        sub[maskBits / 8] |= slot << (maskBits % 8);
+        iso15693Round(sub, maskBits + 4, tags, maxTags, found);
+    }
+}
+
+/**
+ * @brief Find the ISO15693 tags in the field
+ * @param tags Output array
+ * @param maxTags Array capacity
+ * @param slots 1 = try a 1-slot request first, 16 = 16-slot rounds only
+ * @return Number of tags found
+ */
+uint8_t CR95HF::iso15693Inventory(CR95HF_VicinityTag* tags, uint8_t maxTags, uint8_t slots) {
+    if (maxTags == 0 || !selectProtocol(CR95HF_PROTO_ISO15693)) return 0;
+
+    uint8_t found = 0;
+    if (slots == 1) {
+        static const uint8_t req[] = {
+            ISO15693_FLAG_HIGH_RATE | ISO15693_FLAG_INVENTORY | ISO15693_FLAG_1_SLOT,
+            ISO15693_CMD_INVENTORY, 0x00
+        };
+        uint8_t n;
+        bool collision;
+        if (rfRequest(req, sizeof(req), ISO15693_INVENTORY_RSP_LEN, n, collision) &&
+            n >= 2 + ISO15693_UID_LEN &&
+            !(_rfBuf[0] & ISO15693_FLAG_ERROR)) {
+            tags[0].dsfid = _rfBuf[1];
+            memcpy(tags[0].uid, &_rfBuf[2], ISO15693_UID_LEN);
+            return 1;
+        }
+        if (!collision) return 0;
+    }
 
-    // Check for valid ATQA response
-    if (code != CR95HF_RSP_DATA || len < 2) return false;
+    uint8_t none[ISO15693_UID_LEN] = {0};
+    iso15693Round(none, 0, tags, maxTags, found);
+    logValue("[CR95HF] ISO15693 tags: %lu\n", found);
+    return found;
+}
 
-    atqa1 = buf[0];
-    atqa2 = buf[1];
+/**
+ * @brief Read consecutive blocks with READ MULTIPLE BLOCKS
+ * @param uid Tag UID (LSB first)
+ * @param first First block number
+ * @param count Number of blocks
+ * @param out Output: count * blockSize bytes
+ * @param blockSize Tag block size
+ * @return true if every block was read
+ */
+bool CR95HF::iso15693ReadBlocks(const uint8_t* uid, uint8_t first, uint8_t count, uint8_t* out,
+                                uint8_t blockSize) {
+    // Response: code, length, flags, blocks, CRC, status
+    uint8_t perRequest = (sizeof(_rfBuf) - 2 - 1 - 2 - CR95HF_RX15_TRAILER_LEN) / blockSize;
+    if (count == 0 || blockSize == 0 || perRequest == 0 || first + count > 256) return false;
+    if (!selectProtocol(CR95HF_PROTO_ISO15693)) return false;
+
+    while (count) {
+        uint8_t blocks = (count < perRequest) ? count : perRequest;
+        uint8_t req[4 + ISO15693_UID_LEN] = {ISO15693_FLAG_HIGH_RATE | ISO15693_FLAG_ADDRESS,
+                                             ISO15693_CMD_READ_MULTI};
+        memcpy(&req[2], uid, ISO15693_UID_LEN);
+        req[2 + ISO15693_UID_LEN] = first;
+        req[3 + ISO15693_UID_LEN] = blocks - 1;
+
+        uint8_t n;
+        bool collision;
+        if (!rfRequest(req, sizeof(req), 1 + blocks * blockSize + 2, n, collision)) return false;
+        if ((_rfBuf[0] & ISO15693_FLAG_ERROR) || n != 1 + blocks * blockSize) return false;
+
+        memcpy(out, &_rfBuf[1], blocks * blockSize);
+        out += blocks * blockSize;
+        first += blocks;
+        count -= blocks;
+    }
     return true;
 }
+#endif // CR95HF_FEATURE_ISO15693
 
 // ============================================================================
-// Anticollision & Select - Cascade Level 1
+// ISO14443-B / FeliCa
 // ============================================================================
 
+#if CR95HF_FEATURE_ISO14443B
 /**
- * @brief Perform anticollision for cascade level 1
- * @param cl1 Output: 5 bytes (UID[0-3] + BCC)
- * @return true if successful
+ * @brief Poll for an ISO14443-B card
+ * @param pupi Output: PUPI
+ * @param atqb Optional output: ATQB
+ * @return true if one card answered
  */
-bool CR95HF::anticollCL1(uint8_t* cl1) {
-    _txFrame.buildAnticollCL1();
-    sendFrame(_txFrame);
+bool CR95HF::iso14443bGetPUPI(uint8_t* pupi, uint8_t* atqb) {
+    if (!selectProtocol(CR95HF_PROTO_ISO14443B)) return false;
 
-    uint8_t code, buf[16], len = sizeof(buf);
-    if (!readResponse(code, buf, len, 50)) return false;
-    if (code != CR95HF_RSP_DATA || len < 5) return false;
+    static const uint8_t reqb[] = {ISO14443B_APF, 0x00, 0x00};  // All AFI, 1 slot
+    uint8_t n;
+    bool collision;
+    if (!rfRequest(reqb, sizeof(reqb), ISO14443B_ATQB_LEN + 2, n, collision)) return false;
+    if (n < ISO14443B_ATQB_LEN || _rfBuf[0] != ISO14443B_ATQB) return false;
 
-    memcpy(cl1, buf, 5);  // 4 UID bytes + BCC
+    memcpy(pupi, &_rfBuf[1], ISO14443B_PUPI_LEN);
+    if (atqb) memcpy(atqb, _rfBuf, ISO14443B_ATQB_LEN);
     return true;
 }
+#endif
 
+#if CR95HF_FEATURE_FELICA
 /**
- * @brief Select tag with cascade level 1 UID
- * @param cl1 5 bytes: UID[0-3] + BCC
- * @param sak Output: SAK byte
- * @return true if successful
+ * @brief Poll for a FeliCa card
+ * @param idm Output: IDm
+ * @param pmm Optional output: PMm
+ * @return true if one card answered
  */
-bool CR95HF::selectCL1(const uint8_t* cl1, uint8_t& sak) {
-    _txFrame.buildSelectCL1(cl1);
-    sendFrame(_txFrame);
-
-    uint8_t code, buf[8], len = sizeof(buf);
-    if (!readResponse(code, buf, len, 50)) return false;
-    if (code != CR95HF_RSP_DATA || len < 1) return false;
-
-    sak = buf[0];
+bool CR95HF::felicaGetIDm(uint8_t* idm, uint8_t* pmm) {
+    if (!selectProtocol(CR95HF_PROTO_FELICA)) return false;
+
+    // LEN, command, system code FFFF, no request code, 1 slot
+    static const uint8_t sensf[] = {0x06, FELICA_CMD_POLLING, 0xFF, 0xFF, 0x00, 0x00};
+    uint8_t n;
+    bool collision;
+    if (!rfRequest(sensf, sizeof(sensf), FELICA_SENSF_RSP_LEN, n, collision)) return false;
+    if (n < 2 + 2 * FELICA_IDM_LEN || _rfBuf[1] != FELICA_RSP_POLLING) return false;
+
+    memcpy(idm, &_rfBuf[2], FELICA_IDM_LEN);
+    if (pmm) memcpy(pmm, &_rfBuf[2 + FELICA_IDM_LEN], 8);
     return true;
 }
+#endif
 
 // ============================================================================
-// Anticollision & Select - Cascade Level 2
+// Non-Blocking Get UID
 // ============================================================================
 
 /**
- * @brief Perform anticollision for cascade level 2
- * @param cl2 Output: 5 bytes (UID[3-6] + BCC)
- * @return true if successful
+ * @brief Start a non-blocking UID read
+ * @return true if started, false if a read is already in progress
  */
-bool CR95HF::anticollCL2(uint8_t* cl2) {
-    _txFrame.buildAnticollCL2();
-    sendFrame(_txFrame);
-
-    uint8_t code, buf[16], len = sizeof(buf);
-    if (!readResponse(code, buf, len, 50)) return false;
-    if (code != CR95HF_RSP_DATA || len < 5) return false;
-
-    memcpy(cl2, buf, 5);
+bool CR95HF::startGetUID() {
+    if (_asyncStep != ASYNC_IDLE) return false;
+
+    memset(&_asyncResult, 0, sizeof(_asyncResult));
+    _asyncLevel = 0;
+    if (_atqaPending) {
+        // fieldIsEmpty() left the tag READY: straight to anticollision
+        _asyncResult.atqa[0] = lastATQA[0];
+        _asyncResult.atqa[1] = lastATQA[1];
+        asyncIssue(ASYNC_ANTICOLL);
+        return true;
+    }
+    _isoActive = false;
+    _selUidLen = 0;
+    if (_proto != CR95HF_PROTO_ISO14443A || _isoConfigured) {
+        asyncIssue(ASYNC_PROTOCOL);  // Field off, another protocol or ISO-DEP rates
+        return true;
+    }
+    asyncWake();
     return true;
 }
 
 /**
- * @brief Select tag with cascade level 2 UID
- * @param cl2 5 bytes: UID[3-6] + BCC
- * @param sak Output: SAK byte
- * @return true if successful
+ * @brief Abort the non-blocking UID read in progress
  */
-bool CR95HF::selectCL2(const uint8_t* cl2, uint8_t& sak) {
-    _txFrame.buildSelectCL2(cl2);
-    sendFrame(_txFrame);
+void CR95HF::cancel() {
+    if (_asyncStep == ASYNC_FIELD_OFF) {
+        fieldWentOff();             // Already sent: the chip carries it out
+        _tagHalted = false;
+    }
+    _asyncStep = ASYNC_IDLE;
+}
 
-    uint8_t code, buf[8], len = sizeof(buf);
-    if (!readResponse(code, buf, len, 50)) return false;
-    if (code != CR95HF_RSP_DATA || len < 1) return false;
+/**
+ * @brief Wake the tags, once the field has been on for the guard time
+ */
+void CR95HF::asyncWake() {
+    if (_fieldFresh) {
+        _asyncStep = ASYNC_GUARD;   // Tags still powering up: poll() waits
+        return;
+    }
+    asyncIssue(wakeCommand() == ISO14443A_WUPA ? ASYNC_WUPA : ASYNC_REQA);
+}
 
-    sak = buf[0];
-    return true;
+/**
+ * @brief Send the command for a step and arm its timeout
+ * @param step Step to enter (ASYNC_*)
+ */
+void CR95HF::asyncIssue(uint8_t step) {
+    switch (step) {
+        case ASYNC_PROTOCOL:     sendFrame(CR95HF_Frames::PROTO_ISO14443A); break;
+        case ASYNC_ARC:
+            _txFrame.buildWriteArcB(_arcB);
+            sendFrame(_txFrame);
+            break;
+        case ASYNC_WUPA:         sendFrame(CR95HF_Frames::WUPA); break;
+        case ASYNC_REQA:         sendFrame(CR95HF_Frames::REQA); break;
+        case ASYNC_ANTICOLL: sendFrame(anticollFrame(_asyncLevel)); break;
+        case ASYNC_SELECT:   sendFrame(CR95HF_SelectFrame(selCode(_asyncLevel), _asyncCL)); break;
+        case ASYNC_IDN:          sendFrame(CR95HF_Frames::IDN); break;
+        case ASYNC_FIELD_OFF:    sendFrame(CR95HF_Frames::PROTO_OFF); break;
+        default: return;
+    }
+
+    rxReset();
+    _asyncStep = step;
+    _asyncStart = millis();
+    _asyncTimeout = _tmoLastMs = replyTimeout(CR95HF_RX_ISO3_MAX);
 }
 
-// ============================================================================
-// Get UID (4-byte or 7-byte)
-// ============================================================================
+/**
+ * @brief End the non-blocking UID read
+ * @param status Final status
+ * @return status, or CR95HF_ASYNC_BUSY while an empty field gets the
+ *         warm-start IDN check or is switched off
+ */
+CR95HF_AsyncStatus CR95HF::asyncFinish(CR95HF_AsyncStatus status) {
+    if (status == CR95HF_ASYNC_DONE) {
+        setSelected(_asyncResult.uid, _asyncResult.uidLen, _asyncResult.sak);
+    }
+    if (status == CR95HF_ASYNC_NO_TAG && _idnPending) {
+        _asyncEnd = status;
+        asyncIssue(ASYNC_IDN);      // Same spot as the blocking warmCheck()
+        return CR95HF_ASYNC_BUSY;
+    }
+    if (status == CR95HF_ASYNC_NO_TAG && _fieldDuty && _proto != CR95HF_PROTO_OFF) {
+        _asyncEnd = status;
+        asyncIssue(ASYNC_FIELD_OFF);
+        return CR95HF_ASYNC_BUSY;
+    }
+    _asyncStep = ASYNC_IDLE;
+    return status;
+}
 
 /**
- * @brief Read ISO14443-A tag UID
- * @param uid Output buffer (min 10 bytes)
- * @param uidLen Output: UID length (4 or 7)
- * @param sakOut Output: SAK byte
- * @return true if tag detected and UID read
+ * @brief Advance the non-blocking UID read
+ * @param result Output: UID result (valid when CR95HF_ASYNC_DONE)
+ * @return Current status
  *
- * Algorithm:
- * 1. Send WUPA (wake all tags), fallback to REQA
- * 2. Perform anticollision CL1
- * 3. Select CL1
- * 4. If cascade tag (0x88), continue to CL2
- * 5. Extract full UID from CL1 and CL2 responses
+ * Same sequence as iso14443aGetUID(), one step per completed response:
+ * (ProtocolSelect [-> ARC_B]) -> WUPA -> (REQA) -> anticoll + select CL1
+ * [-> CL2 [-> CL3]]; no tag: (-> IDN after beginFast()) (-> PROTO_OFF
+ * with duty cycling)
  */
-bool CR95HF::iso14443aGetUID(uint8_t* uid, uint8_t& uidLen, uint8_t& sakOut) {
-    uidLen = 0;
-    sakOut = 0;
+CR95HF_AsyncStatus CR95HF::poll(CR95HF_UIDResult& result) {
+    if (_asyncStep == ASYNC_IDLE) return CR95HF_ASYNC_IDLE;
+
+    if (_asyncStep == ASYNC_GUARD) {
+        if (micros() - _fieldOnUs < _guardUs) return CR95HF_ASYNC_BUSY;
+        _fieldFresh = false;
+        asyncIssue(wakeCommand() == ISO14443A_WUPA ? ASYNC_WUPA : ASYNC_REQA);
+        return CR95HF_ASYNC_BUSY;
+    }
 
-    // Try WUPA first (wakes halted cards), then REQA
-    uint8_t atqa1 = 0, atqa2 = 0;
-    bool gotAtqa = sendReqWup(ISO14443A_WUPA, atqa1, atqa2);
-    if (!gotAtqa) {
-        gotAtqa = sendReqWup(ISO14443A_REQA, atqa1, atqa2);
+    bool expired = millis() - _asyncStart > _asyncTimeout;   // Before the bytes
+    bool ok = rxProcess(_rfBuf, CR95HF_RX_ISO3_MAX);
+    if (!ok && !expired) {
+        return CR95HF_ASYNC_BUSY;  // Response still in flight
     }
-    if (!gotAtqa) {
-        return false;  // No tag in field
+
+    uint8_t len = (_rxCount < CR95HF_RX_ISO3_MAX) ? _rxCount : CR95HF_RX_ISO3_MAX;
+    if (ok) {
+        statResponse(_rxCode);
+    } else {
+        statTimeout();
     }
+    traceRx(ok, _rfBuf, len, _asyncTimeout);
+    if (ok) logFrame(CR95HF_LOG_RX, _rxCode, _rfBuf, len);
+    bool silent = ok && _rxCode == CR95HF_RSP_TIMEOUT;
+    CR95HF_ResponseView rsp = viewOf(ok ? _rxCode : 0, len);
+
+    bool success = ok && _rxCode == CR95HF_RSP_SUCCESS;
+
+    switch (_asyncStep) {
+        case ASYNC_PROTOCOL:
+            if (!success) return asyncFinish(CR95HF_ASYNC_ERROR);
+            protocolSelected(CR95HF_PROTO_ISO14443A);
+            if (_arcB) {
+                asyncIssue(ASYNC_ARC);      // ProtocolSelect reloaded the default
+            } else {
+                asyncWake();
+            }
+            return CR95HF_ASYNC_BUSY;
+
+        case ASYNC_ARC:
+            if (!success) return asyncFinish(CR95HF_ASYNC_ERROR);
+            asyncWake();
+            return CR95HF_ASYNC_BUSY;
+
+        case ASYNC_IDN: {
+            _idnPending = false;
+            if (!success) {
+                log("[CR95HF] Warm start IDN check failed\n");
+                return asyncFinish(_asyncEnd);
+            }
+            char name[sizeof(CR95HF_WarmState::deviceName)];
+            uint8_t n = (len < sizeof(name) - 1) ? len : sizeof(name) - 1;
+            memcpy(name, _rfBuf, n);
+            name[n] = '\0';
+            warmCompare(name);
+            return asyncFinish(_asyncEnd);
+        }
 
-    // Store ATQA for debugging
-    lastATQA[0] = atqa1;
-    lastATQA[1] = atqa2;
+        case ASYNC_FIELD_OFF:
+            fieldWentOff();                 // Off even if the answer was lost
+            _tagHalted = false;
+            _asyncStep = ASYNC_IDLE;
+            return _asyncEnd;
+
+        case ASYNC_WUPA:
+        case ASYNC_REQA:
+            if (rsp.code != CR95HF_RSP_DATA || rsp.len < 2) {
+                // Garbled WUPA answer: fall back to REQA once, then give up.
+                // A silent field stays silent for REQA.
+                if (_asyncStep == ASYNC_WUPA && !silent) {
+                    asyncIssue(ASYNC_REQA);
+                    return CR95HF_ASYNC_BUSY;
+                }
+                return asyncFinish(CR95HF_ASYNC_NO_TAG);
+            }
+            _tagHalted = false;
+            _asyncResult.atqa[0] = lastATQA[0] = rsp.data[0];
+            _asyncResult.atqa[1] = lastATQA[1] = rsp.data[1];
+            asyncIssue(ASYNC_ANTICOLL);
+            return CR95HF_ASYNC_BUSY;
+
+        case ASYNC_ANTICOLL: {
+            if (!tagAnswer(rsp, 5) || !bccOk(rsp.data)) return asyncFinish(CR95HF_ASYNC_ERROR);
+
+            // UID bytes straight into the result; cascade tag: 3 bytes
+            uint8_t n = levelBytes(_asyncLevel, rsp.data);
+            memcpy(&_asyncResult.uid[_asyncResult.uidLen], &rsp.data[4 - n], n);
+            _asyncResult.uidLen += n;
+            _asyncCL = rsp.data;    // SELECT frame built from the buffer
+            asyncIssue(ASYNC_SELECT);
+            return CR95HF_ASYNC_BUSY;
+        }
 
-    // Anticollision CL1
-    uint8_t cl1[5];
-    if (!anticollCL1(cl1)) {
-        return false;
+        case ASYNC_SELECT:
+            if (!tagAnswer(rsp, 1)) return asyncFinish(CR95HF_ASYNC_ERROR);
+            if (_asyncResult.uidLen == 3 * (_asyncLevel + 1)) {
+                _asyncLevel++;                      // Cascade tag: next level
+                asyncIssue(ASYNC_ANTICOLL);
+                return CR95HF_ASYNC_BUSY;
+            }
+            _asyncResult.sak = rsp.data[0];
+            result = _asyncResult;
+            return asyncFinish(CR95HF_ASYNC_DONE);
+
+        default:
+            return asyncFinish(CR95HF_ASYNC_ERROR);
     }
+}
+
+// ============================================================================
+// Background Reader Task
+// ============================================================================
 
-    // Select CL1
-    uint8_t sak1 = 0;
-    if (!selectCL1(cl1, sak1)) {
+/**
+ * @brief Start background reader task
+ * @param periodMs Poll period in milliseconds
+ * @param core CPU core to pin the task to
+ * @param priority FreeRTOS task priority
+ * @param stackSize Task stack size in bytes
+ * @return true if task started
+ */
+bool CR95HF::startTask(uint32_t periodMs, BaseType_t core, UBaseType_t priority, uint32_t stackSize) {
+    if (_task != NULL) return false;
+
+    if (_taskDone == NULL) {
+        _taskDone = xSemaphoreCreateBinaryStatic(&_taskDoneBuf);
+        if (_taskDone == NULL) return false;
+    }
+    xSemaphoreTake(_taskDone, 0);  // Clear a give nobody waited for
+
+    _taskPeriod = periodMs ? periodMs : 1;
+    _taskRun = true;
+    // The handle is stored before the task first runs, so its exit cannot
+    // be overwritten
+    if (xTaskCreatePinnedToCore(taskEntry, "cr95hf", stackSize, this,
+                                priority, const_cast<TaskHandle_t*>(&_task), core) != pdPASS) {
+        _task = NULL;
+        _taskRun = false;
+        log("[CR95HF] Task create failed\n");
         return false;
     }
+    return true;
+}
 
-    // Check for cascade tag (0x88 = more UID bytes follow)
-    if (cl1[0] != ISO14443A_CT) {
-        // 4-byte UID (single size) - most common for MIFARE Classic
-        uid[0] = cl1[0];
-        uid[1] = cl1[1];
-        uid[2] = cl1[2];
-        uid[3] = cl1[3];
-        uidLen = 4;
-        sakOut = sak1;
-        return true;
-    }
+/**
+ * @brief Stop background reader task
+ *
+ * Returns once the task has left the driver: it gives _taskDone as its
+ * last access to the object. Called from the task itself (a scan
+ * callback), it only asks the loop to end, which happens once the
+ * callback returns.
+ */
+void CR95HF::stopTask() {
+    _taskRun = false;
+    if (_task == NULL || xTaskGetCurrentTaskHandle() == _task) return;
+    xSemaphoreTake(_taskDone, portMAX_DELAY);
+}
 
-    // 7-byte UID: first 3 bytes from CL1 (skip cascade tag 0x88)
-    uid[0] = cl1[1];
-    uid[1] = cl1[2];
-    uid[2] = cl1[3];
+/**
+ * @brief FreeRTOS task entry point
+ * @param arg CR95HF instance
+ */
+void CR95HF::taskEntry(void* arg) {
+    static_cast<CR95HF*>(arg)->taskLoop();
+}
 
-    // Anticollision CL2
-    uint8_t cl2[5];
-    if (!anticollCL2(cl2)) {
-        return false;
+/**
+ * @brief Background detection loop
+ *
+ * Polls at a fixed cadence (vTaskDelayUntil) independent of exchange time,
+ * publishing one event per successful read. The queue is never blocked on:
+ * if the consumer falls behind, new events are dropped and counted. In
+ * continuous-scan mode reads go to the batch instead, and a read that
+ * failed after a tag answered is retried at once.
+ */
+void CR95HF::taskLoop() {
+    TickType_t lastWake = xTaskGetTickCount();
+    CR95HF_TagEvent ev;
+
+    while (_taskRun) {
+        bool read = iso14443aGetUID(ev.uid, ev.uidLen, ev.sak);
+        for (uint8_t r = 0; !read && _scanCb && r < _scanCfg.retries &&
+                            _wakeRsp != 0 && _wakeRsp != CR95HF_RSP_TIMEOUT; r++) {
+            _scanRetries = _scanRetries + 1;
+            read = iso14443aGetUID(ev.uid, ev.uidLen, ev.sak);
+        }
+
+        if (read) {
+            ev.atqa[0] = lastATQA[0];
+            ev.atqa[1] = lastATQA[1];
+            ev.timestamp = millis();
+            if (_scanCb) {
+                scanAdd(ev);
+            } else if (!_events.push(ev)) {
+                _eventsDropped = _eventsDropped + 1;
+            }
+        }
+        if (_scanCount && _scanCfg.batchMs && millis() - _scanFirstMs >= _scanCfg.batchMs) {
+            scanDeliver();
+        }
+
+        // Duty-cycled field: back on one guard time before the next poll
+        TickType_t period = pdMS_TO_TICKS(_taskPeriod);
+        TickType_t guard = pdMS_TO_TICKS((_guardUs + 999) / 1000);
+        if (_fieldDuty && _proto == CR95HF_PROTO_OFF && guard < period) {
+            vTaskDelayUntil(&lastWake, period - guard);
+            fieldOn();
+            vTaskDelayUntil(&lastWake, guard);
+        } else {
+            vTaskDelayUntil(&lastWake, period);
+        }
     }
 
-    // Select CL2
-    uint8_t sak2 = 0;
-    if (!selectCL2(cl2, sak2)) {
+    if (_scanCount) scanDeliver();  // Nothing held back after a stop
+    _scanCb = nullptr;
+    _task = NULL;
+    xSemaphoreGive(_taskDone);
+    vTaskDelete(NULL);
+}
+
+// ============================================================================
+// Continuous Scan
+// ============================================================================
+
+/**
+ * @brief Start the background task in batched-callback mode
+ * @param config Scan settings
+ * @param callback Batch callback
+ * @return true if the scan task started
+ */
+bool CR95HF::startContinuousScan(const CR95HF_ScanConfig& config, CR95HF_ScanCallback callback) {
+    if (_task != NULL || !callback) return false;
+    if (config.batchSize == 0 || config.batchSize > CR95HF_SCAN_BATCH_MAX) return false;
+
+    _scanCfg = config;
+    _scanCb = callback;
+    _scanCount = 0;
+    _scanBatches = 0;
+    _scanRetries = 0;
+    if (!startTask(config.periodMs, config.core, config.priority, config.stackSize)) {
+        _scanCb = nullptr;
         return false;
     }
+    return true;
+}
+
+/**
+ * @brief Stop the continuous scan
+ *
+ * The task delivers its pending batch and drops the callback before it
+ * exits; afterwards startTask() runs in event-queue mode again.
+ */
+void CR95HF::stopContinuousScan() {
+    stopTask();
+}
 
-    // Remaining 4 bytes from CL2
-    uid[3] = cl2[0];
-    uid[4] = cl2[1];
-    uid[5] = cl2[2];
-    uid[6] = cl2[3];
-    uidLen = 7;
-    sakOut = sak2;
+/**
+ * @brief Hold one read for the next batch
+ * @param ev Detection record
+ */
+void CR95HF::scanAdd(const CR95HF_TagEvent& ev) {
+    if (_scanCfg.dedupe) {
+        for (uint8_t i = 0; i < _scanCount; i++) {
+            const CR95HF_TagEvent& e = _scanBatch[i];
+            if (e.uidLen == ev.uidLen && memcmp(e.uid, ev.uid, ev.uidLen) == 0) return;
+        }
+    }
 
-    return true;
+    if (_scanCount == 0) _scanFirstMs = ev.timestamp;
+    _scanBatch[_scanCount++] = ev;
+    if (_scanCount >= _scanCfg.batchSize) scanDeliver();
 }
 
 /**
- * @brief Read ISO14443-A tag UID (without SAK)
- * @param uid Output buffer (min 10 bytes)
- * @param uidLen Output: UID length
- * @return true if tag detected
+ * @brief Hand the held records to the callback in one call
  */
-bool CR95HF::iso14443aGetUID(uint8_t* uid, uint8_t& uidLen) {
-    uint8_t sak;
-    return iso14443aGetUID(uid, uidLen, sak);
+void CR95HF::scanDeliver() {
+    uint8_t n = _scanCount;
+    _scanCount = 0;
+    _scanBatches = _scanBatches + 1;
+    _scanCb(_scanBatch, n);
 }
 
+#if CR95HF_FEATURE_NAMES
 // ============================================================================
 // Card Type from SAK
 // ============================================================================
@@ -455,6 +2942,7 @@ const char* CR95HF::getCardType(uint8_t sak) {
         default:                 return "Unknown";
     }
 }
+#endif // CR95HF_FEATURE_NAMES
 
 // ============================================================================
 // Read IDN
@@ -469,11 +2957,10 @@ const char* CR95HF::getCardType(uint8_t sak) {
 bool CR95HF::readIDN(char* out, uint8_t maxLen) {
     if (!out || maxLen == 0) return false;
 
-    _txFrame.buildIDN();
-    sendFrame(_txFrame);
+    sendFrame(CR95HF_Frames::IDN);
 
     uint8_t code, buf[32], len = sizeof(buf);
-    if (!readResponse(code, buf, len, 100)) return false;
+    if (!readResponse(code, buf, len)) return false;
     if (code != CR95HF_RSP_SUCCESS) return false;
 
     uint8_t copyLen = (len < maxLen - 1) ? len : (maxLen - 1);
@@ -483,6 +2970,7 @@ bool CR95HF::readIDN(char* out, uint8_t maxLen) {
     return true;
 }
 
+#if CR95HF_FEATURE_DIAGNOSTICS
 // ============================================================================
 // Self Test
 // ============================================================================
@@ -504,34 +2992,19 @@ void CR95HF::selfTest() {
     Serial.printf("  IDN:      %s\n", idnOk ? idn : "FAIL");
 
     // Protocol select
-    bool protoOk = protocolSelectA();
+    bool protoOk = selectProtocol(CR95HF_PROTO_ISO14443A, true);
     Serial.printf("  Protocol: %s\n", protoOk ? "ISO14443A OK" : "FAIL");
 
-    // RF Field test
+    // RF field: one WUPA, classified like measureFieldLevel()
     uint8_t a1, a2;
-    bool fieldOk = sendReqWup(ISO14443A_WUPA, a1, a2) ||
-                   sendReqWup(ISO14443A_REQA, a1, a2);
-
-    if (fieldOk) {
+    if (sendReqWup(ISO14443A_WUPA, a1, a2)) {
         Serial.printf("  RF Field: OK (tag present, ATQA=%02X%02X)\n", a1, a2);
+    } else if (_wakeRsp == CR95HF_RSP_TIMEOUT) {
+        Serial.println("  RF Field: OK (no tag)");
+    } else if (_wakeRsp != 0) {
+        Serial.printf("  RF Field: response 0x%02X\n", _wakeRsp);
     } else {
-        // No tag - re-select protocol to ensure field is on
-        protocolSelectA();
-
-        // Send REQA just to check field response
-        _txFrame.buildREQA();
-        sendFrame(_txFrame);
-
-        uint8_t code, buf[8], len = sizeof(buf);
-        if (readResponse(code, buf, len, 50)) {
-            if (code == CR95HF_RSP_TIMEOUT) {
-                Serial.println("  RF Field: OK (no tag)");
-            } else {
-                Serial.printf("  RF Field: response 0x%02X\n", code);
-            }
-        } else {
-            Serial.println("  RF Field: FAIL (no response)");
-        }
+        Serial.println("  RF Field: FAIL (no response)");
     }
 
     Serial.println("========================\n");
@@ -547,34 +3020,23 @@ void CR95HF::selfTest() {
  * @return true if measurement successful
  */
 bool CR95HF::measureFieldLevel(uint8_t& level) {
-    // Re-select protocol to ensure field is on
-    if (!protocolSelectA()) {
+    // Field on in ISO14443-A (no command if already selected)
+    if (!selectProtocol(CR95HF_PROTO_ISO14443A)) {
         level = 0;
         return false;
     }
 
-    // Try WUPA/REQA
+    // One WUPA: its answer (or the CR95HF's "no tag") tells it all
     uint8_t a1, a2;
-    if (sendReqWup(ISO14443A_WUPA, a1, a2) || sendReqWup(ISO14443A_REQA, a1, a2)) {
+    if (sendReqWup(ISO14443A_WUPA, a1, a2)) {
         level = 100;  // Tag present = strong field
-        return true;
-    }
-
-    // No tag - check if field is at least active
-    _txFrame.buildREQA();
-    sendFrame(_txFrame);
-
-    uint8_t code, buf[8], len = sizeof(buf);
-    if (readResponse(code, buf, len, 50)) {
-        if (code == CR95HF_RSP_TIMEOUT) {
-            level = 50;  // Field on, no tag
-        } else {
-            level = 25;  // Some response
-        }
+    } else if (_wakeRsp == CR95HF_RSP_TIMEOUT) {
+        level = 50;   // Field on, no tag
+    } else if (_wakeRsp != 0) {
+        level = 25;   // Some response
     } else {
-        level = 0;  // No response at all
+        level = 0;    // No response at all
     }
-
     return true;
 }
 
@@ -591,3 +3053,222 @@ bool CR95HF::antennaOK() {
     if (!measureFieldLevel(level)) return false;
     return level > 0;
 }
+#endif // CR95HF_FEATURE_DIAGNOSTICS
+
+// ============================================================================
+// Low-Power Tag Detection
+// ============================================================================
+
+/**
+ * @brief Run one tag detector calibration step
+ * @param dacH DAC threshold to test
+ * @return Wake-up source (CR95HF_WU_*), 0 on communication failure
+ */
+uint8_t CR95HF::idleCalibProbe(uint8_t dacH) {
+    _txFrame.buildIdle(CR95HF_WU_TIMEOUT | CR95HF_WU_TAG_DETECT,
+                       CR95HF_IDLE_ENTER_CALIB, CR95HF_IDLE_WU_CALIB,
+                       CR95HF_IDLE_CALIB_PERIOD, 0x00, dacH, CR95HF_IDLE_CALIB_SLEEP);
+    sendFrame(_txFrame);
+    fieldWentOff();             // Idle switches the field off
+
+    uint32_t sleep = 256UL * (CR95HF_IDLE_CALIB_PERIOD + 2) * (CR95HF_IDLE_CALIB_SLEEP + 1);
+    uint8_t code, buf[4], len = sizeof(buf);
+    if (!readResponse(code, buf, len, idleTimeout(sleep))) return 0;
+    if (code != CR95HF_RSP_SUCCESS || len < 1) return 0;
+    return buf[0];
+}
+
+/**
+ * @brief Calibrate the tag detector DAC reference
+ * @param dacRef Output: calibrated reference
+ * @return true if calibration succeeded
+ *
+ * Invariant: threshold lo triggers the detector, hi times out. Each probe
+ * halves the interval, down to the 4-LSB DAC resolution (6 probes).
+ */
+bool CR95HF::calibrateTagDetector(uint8_t& dacRef) {
+    uint8_t lo = 0x00, hi = 0xFC;
+
+    if (idleCalibProbe(lo) != CR95HF_WU_TAG_DETECT ||
+        idleCalibProbe(hi) != CR95HF_WU_TIMEOUT) {
+        log("[CR95HF] Tag detector calibration failed\n");
+        selectProtocol(CR95HF_PROTO_ISO14443A);
+        return false;
+    }
+
+    while (hi - lo > 0x04) {
+        uint8_t mid = ((lo + hi) / 2) & 0xFC;
+        uint8_t wu = idleCalibProbe(mid);
+        if (wu == CR95HF_WU_TAG_DETECT) {
+            lo = mid;
+        } else if (wu == CR95HF_WU_TIMEOUT) {
+            hi = mid;
+        } else {
+            selectProtocol(CR95HF_PROTO_ISO14443A);
+            return false;
+        }
+    }
+
+    dacRef = lo;
+    setTagDetectorRef(lo, _tdGuard);
+    logValue("[CR95HF] Tag detector ref 0x%02lX\n", lo);
+
+    // Idle switches the field off: restore reader mode
+    return selectProtocol(CR95HF_PROTO_ISO14443A);
+}
+
+/**
+ * @brief Set tag detector reference
+ * @param dacRef DAC reference
+ * @param guard Detection window half-width
+ */
+void CR95HF::setTagDetectorRef(uint8_t dacRef, uint8_t guard) {
+    _tdRef = dacRef;
+    _tdGuard = guard;
+    _tdValid = true;
+}
+
+/**
+ * @brief Sleep in tag-detector mode until a tag approaches
+ * @param timeoutMs Host-side timeout in milliseconds
+ * @param wuPeriod Time between detections
+ * @return true if woken by the tag detector
+ */
+bool CR95HF::waitForTag(uint32_t timeoutMs, uint8_t wuPeriod) {
+    if (!_tdValid) return false;
+
+    uint8_t dacL = (_tdRef > _tdGuard) ? _tdRef - _tdGuard : 0x00;
+    uint8_t dacH = (_tdRef < 0xFC - _tdGuard) ? _tdRef + _tdGuard : 0xFC;
+
+    // Tag detect + IRQ_IN only: the host decides when to give up
+    _txFrame.buildIdle(CR95HF_WU_TAG_DETECT | CR95HF_WU_IRQ_IN,
+                       CR95HF_IDLE_ENTER_TAGDET, CR95HF_IDLE_WU_TAGDET,
+                       wuPeriod, dacL, dacH, 0x00);
+    sendFrame(_txFrame);
+    fieldWentOff();
+
+    uint8_t code, buf[4], len = sizeof(buf);
+    bool woke = readResponse(code, buf, len, timeoutMs);
+    if (!woke) {
+        // Host timeout: pull the chip out of Idle ourselves
+        _link->wakeUp();
+        len = sizeof(buf);
+        woke = readResponse(code, buf, len, idleTimeout(0));
+    }
+
+    bool tag = woke && code == CR95HF_RSP_SUCCESS && len >= 1 &&
+               buf[0] == CR95HF_WU_TAG_DETECT;
+
+    // Idle switches the field off: restore reader mode
+    if (!selectProtocol(CR95HF_PROTO_ISO14443A)) return false;
+    return tag;
+}
+
+// ============================================================================
+// Analog Tuning (ARC_B)
+// ============================================================================
+
+/**
+ * @brief Write ARC_B
+ * @param value Modulation index | receiver gain
+ * @return true if the CR95HF accepted
+ */
+bool CR95HF::writeArcB(uint8_t value) {
+    _txFrame.buildWriteArcB(value);
+    sendFrame(_txFrame);
+
+    uint8_t code, buf[4], len = sizeof(buf);
+    return readResponse(code, buf, len) && code == CR95HF_RSP_SUCCESS;
+}
+
+/**
+ * @brief Read ARC_B back from the CR95HF
+ * @param arcB Output: register value
+ * @return true if read
+ */
+bool CR95HF::readArcB(uint8_t& arcB) {
+    // Point the index at ARC_B, then read the indexed value
+    static const uint8_t setIndex[] = {CR95HF_CMD_WRREG, 0x03, CR95HF_REG_ARC_INDEX, 0x00,
+                                       CR95HF_ARC_B_INDEX};
+    static const uint8_t read[] = {CR95HF_CMD_RDREG, 0x03, CR95HF_REG_ARC_DATA, 0x01, 0x00};
+
+    sendFrame(setIndex);
+    uint8_t code, buf[4], len = sizeof(buf);
+    if (!readResponse(code, buf, len) || code != CR95HF_RSP_SUCCESS) return false;
+
+    sendFrame(read);
+    len = sizeof(buf);
+    if (!readResponse(code, buf, len) || code != CR95HF_RSP_SUCCESS || len < 1) return false;
+    arcB = buf[0];
+    return true;
+}
+
+/**
+ * @brief Use an ISO14443-A ARC_B setting
+ * @param arcB Setting, 0 = chip default
+ * @return true if applied
+ */
+bool CR95HF::setArcB(uint8_t arcB) {
+    _arcB = arcB;
+    if (_proto != CR95HF_PROTO_ISO14443A) return true;  // Applied by the next select
+
+    // 0: a ProtocolSelect reloads the default
+    return arcB ? writeArcB(arcB) : selectProtocol(CR95HF_PROTO_ISO14443A, true);
+}
+
+/**
+ * @brief Find the best ISO14443-A ARC_B setting with a reference tag
+ * @param arcB Output: best setting
+ * @param trials UID reads per setting
+ * @return false if no setting read the tag
+ *
+ * The tag is halted after each read so every trial starts the same way
+ * (WUPA answered at once, no REQA fallback).
+ */
+bool CR95HF::autoTuneAnalog(uint8_t& arcB, uint8_t trials) {
+    static const uint8_t mods[] = {0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0xD};  // 10% .. 95%
+    static const uint8_t gains[] = {0x0, 0x1, 0x3, 0x7};                // 34 .. 20 dB
+
+    uint8_t prev = _arcB;
+    uint8_t best = 0, bestOk = 0;
+    uint32_t bestUs = 0;
+    if (trials == 0) trials = 1;
+
+    for (uint8_t m = 0; m < sizeof(mods); m++) {
+        for (uint8_t g = 0; g < sizeof(gains); g++) {
+            uint8_t value = (mods[m] << 4) | gains[g];
+            if (!selectProtocol(CR95HF_PROTO_ISO14443A) || !setArcB(value)) {
+                setArcB(prev);
+                return false;
+            }
+
+            uint8_t ok = 0;
+            uint32_t us = 0;
+            for (uint8_t t = 0; t < trials; t++) {
+                uint8_t uid[10], uidLen, sak;
+                uint32_t t0 = micros();
+                if (!iso14443aGetUID(uid, uidLen, sak)) continue;
+                us += micros() - t0;
+                ok++;
+                halt();
+            }
+
+            uint32_t mean = ok ? us / ok : 0;
+            if (ok > bestOk || (ok == bestOk && ok && mean < bestUs)) {
+                best = value;
+                bestOk = ok;
+                bestUs = mean;
+            }
+        }
+    }
+
+    if (bestOk == 0) {
+        log("[CR95HF] ARC_B tuning: no tag read\n");
+        setArcB(prev);
+        return false;
+    }
+
+    arcB = best;
+    logValue("[CR95HF] ARC_B 0x%02lX\n", best);
+    return setArcB(best);
+}
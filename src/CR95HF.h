@@ -10,9 +10,9 @@
  * NTAG, and other ISO14443-A compatible cards.
  *
  * Key features:
- * - UART communication (57600 baud, 8N2)
+ * - UART communication (57600 baud, 8N2) or SPI (see CR95HF_SpiTransport.h)
  * - ISO14443-A anticollision and selection
- * - 4-byte and 7-byte UID support
+ * - 4-byte, 7-byte and 10-byte UID support
  * - SAK-based card type identification
  * - Frame builder for protocol commands
  *
@@ -55,6 +55,58 @@
 #pragma once
 
 #include <Arduino.h>
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+#include <atomic>
+#include <functional>
+#include "CR95HF_Transport.h"
+#include "CR95HF_Trace.h"
+
+// ============================================================================
+// Build Configuration
+// Set from the compiler command line (PlatformIO build_flags, arduino-cli
+// --build-property compiler.cpp.extra_flags=...): a #define in the sketch
+// does not reach the library sources. 0 removes the feature, its API and
+// its RAM; buffer sizes below (CR95HF_RF_BUFFER, CR95HF_TX_BUFFER,
+// CR95HF_LOG_SIZE, caches) follow the same rule.
+// ============================================================================
+
+/// Debug output of begin(debug), deferred log ring and log task
+#ifndef CR95HF_FEATURE_DEBUG
+#define CR95HF_FEATURE_DEBUG        1
+#endif
+
+/// selfTest(), measureFieldLevel(), antennaOK() and the deviceName string
+#ifndef CR95HF_FEATURE_DIAGNOSTICS
+#define CR95HF_FEATURE_DIAGNOSTICS  1
+#endif
+
+/// Name tables: getCardType(), getModelName()
+#ifndef CR95HF_FEATURE_NAMES
+#define CR95HF_FEATURE_NAMES        1
+#endif
+
+/// ISO15693: iso15693Inventory(), iso15693ReadBlocks()
+#ifndef CR95HF_FEATURE_ISO15693
+#define CR95HF_FEATURE_ISO15693     1
+#endif
+
+/// ISO14443-B: iso14443bGetPUPI()
+#ifndef CR95HF_FEATURE_ISO14443B
+#define CR95HF_FEATURE_ISO14443B    1
+#endif
+
+/// FeliCa: felicaGetIDm()
+#ifndef CR95HF_FEATURE_FELICA
+#define CR95HF_FEATURE_FELICA       1
+#endif
+
+/// Any protocol with a 1-byte status trailer (ISO15693, ISO14443-B, FeliCa)
+#define CR95HF_FEATURE_STATUS1 \
+    (CR95HF_FEATURE_ISO15693 || CR95HF_FEATURE_ISO14443B || CR95HF_FEATURE_FELICA)
 
 // ============================================================================
 // CR95HF Command Codes (Host -> CR95HF)
@@ -67,6 +119,7 @@
 #define CR95HF_CMD_IDLE         0x07    ///< Enter low-power idle mode
 #define CR95HF_CMD_RDREG        0x08    ///< Read analog configuration register
 #define CR95HF_CMD_WRREG        0x09    ///< Write analog configuration register
+#define CR95HF_CMD_BAUDRATE     0x0A    ///< Change UART baud rate
 #define CR95HF_CMD_ECHO         0x55    ///< Echo test command (returns 0x55)
 
 // ============================================================================
@@ -93,6 +146,54 @@
 #define CR95HF_PROTO_ISO14443B  0x03    ///< ISO14443-B (NFC-B)
 #define CR95HF_PROTO_FELICA     0x04    ///< FeliCa (NFC-F)
 
+/// RF field off time for a field reset, and tag power-up time after it (ms)
+#define CR95HF_FIELD_RESET_MS   5
+
+/// Tag power-up time before the first RF command after field-on (us)
+#ifndef CR95HF_FIELD_GUARD_US
+#define CR95HF_FIELD_GUARD_US   5100
+#endif
+
+// ============================================================================
+// CR95HF Idle Command Parameters
+// Reference: CR95HF Datasheet Section 5.7
+// ============================================================================
+
+// Wake-up sources (WUSource byte, also returned in the Idle response)
+#define CR95HF_WU_TIMEOUT       0x01    ///< Wake-up by timeout (MaxSleep expired)
+#define CR95HF_WU_TAG_DETECT    0x02    ///< Wake-up by tag detector
+#define CR95HF_WU_IRQ_IN        0x08    ///< Wake-up by low pulse on IRQ_IN
+
+// Control words (EnterCtrl / WUCtrl / LeaveCtrl)
+#define CR95HF_IDLE_ENTER_CALIB 0x00A1  ///< Enter tag detector calibration
+#define CR95HF_IDLE_ENTER_TAGDET 0x0021 ///< Enter tag detection
+#define CR95HF_IDLE_WU_CALIB    0x01B8  ///< Wake-up control for calibration
+#define CR95HF_IDLE_WU_TAGDET   0x0179  ///< Wake-up control for tag detection
+#define CR95HF_IDLE_LEAVE       0x0018  ///< Leave control (back to Ready)
+
+#define CR95HF_IDLE_OSC_START   0x60    ///< Oscillator start-up delay
+#define CR95HF_IDLE_DAC_START   0x60    ///< DAC start-up delay
+#define CR95HF_IDLE_SWINGS      0x3F    ///< Number of RF swings per detection
+
+// Idle timing: start-up delays count LFO periods, a WU period is
+// 256 * (WUPeriod + 2) of them and MaxSleep + 1 periods end a timeout sleep
+#define CR95HF_IDLE_LFO_US      32      ///< 32 kHz LFO period, rounded up (us)
+#define CR95HF_IDLE_CALIB_PERIOD 0x02   ///< Calibration WU period
+#define CR95HF_IDLE_CALIB_SLEEP 0x01    ///< Calibration MaxSleep: wake after two periods
+
+// ============================================================================
+// CR95HF Analog Configuration (ARC_B)
+// Reference: CR95HF Datasheet Section 5.8
+// ARC_B = modulation index (bits 7:4) | receiver gain (bits 3:0). Every
+// ProtocolSelect reloads the protocol default.
+// ============================================================================
+
+#define CR95HF_REG_ARC_INDEX    0x68    ///< WrReg address: ARC register index
+#define CR95HF_REG_ARC_DATA     0x69    ///< RdReg address: indexed ARC value
+#define CR95HF_REG_INC_ADDR     0x01    ///< WrReg flag: write index, then value
+#define CR95HF_ARC_B_INDEX      0x01    ///< Index of ARC_B
+#define CR95HF_ARC_B_DEFAULT    0xD3    ///< ISO14443-A default (95%, 27 dB)
+
 // ============================================================================
 // ISO14443-A RF Commands
 // Reference: ISO/IEC 14443-3A
@@ -108,9 +209,152 @@
 #define ISO14443A_SEL_CL1       0x93    ///< Select cascade level 1 (UID bytes 0-3)
 #define ISO14443A_SEL_CL2       0x95    ///< Select cascade level 2 (UID bytes 3-6)
 #define ISO14443A_SEL_CL3       0x97    ///< Select cascade level 3 (UID bytes 6-9, rare)
+#define ISO14443A_CASCADE_LEVELS 3      ///< Cascade levels (4/7/10-byte UIDs)
 #define ISO14443A_NVB_ANTICOLL  0x20    ///< NVB for anticollision (0 UID bits known)
 #define ISO14443A_NVB_SELECT    0x70    ///< NVB for select (all 40 UID bits known)
 
+// ============================================================================
+// ISO14443-4 (ISO-DEP) Block Protocol
+// Reference: ISO/IEC 14443-4
+// ============================================================================
+
+#define ISO14443_4_RATS         0xE0    ///< Request for Answer To Select
+#define ISO14443_4_PPS          0xD0    ///< Protocol and Parameter Selection (CID 0)
+#define ISO14443_4_PCB_I        0x02    ///< I-block (information)
+#define ISO14443_4_PCB_CHAIN    0x10    ///< I-block chaining bit (more data follows)
+#define ISO14443_4_PCB_R_ACK    0xA2    ///< R-block acknowledge
+#define ISO14443_4_PCB_R_NAK    0xB2    ///< R-block negative acknowledge
+#define ISO14443_4_PCB_DESELECT 0xC2    ///< S-block DESELECT
+#define ISO14443_4_PCB_WTX      0xF2    ///< S-block waiting time extension
+
+#define CR95HF_ISO_RETRIES      2       ///< Retransmissions per block (rules 4/5)
+#define CR95HF_ATS_MAX          20      ///< ATS bytes kept
+
+/// RF exchange buffer: ISO-DEP frame size 128 (FSD) + 3 status bytes.
+/// Smaller buffers lower the FSD announced in RATS and split NTAG / ISO15693
+/// reads into more requests.
+#ifndef CR95HF_RF_BUFFER
+#define CR95HF_RF_BUFFER        132
+#endif
+static_assert(CR95HF_RF_BUFFER >= 32 && CR95HF_RF_BUFFER <= 255,
+              "CR95HF_RF_BUFFER must be 32-255 bytes");
+
+// ============================================================================
+// NTAG / MIFARE Ultralight Memory
+// Reference: NXP NTAG213/215/216 datasheet, NFC Forum Type 2 Tag
+// ============================================================================
+
+#define NTAG_CMD_READ           0x30    ///< READ: 4 pages from a start page
+#define NTAG_CMD_FAST_READ      0x3A    ///< FAST_READ: start page to end page
+#define NTAG_CMD_GET_VERSION    0x60    ///< GET_VERSION: vendor, type, storage size
+#define ULC_CMD_AUTH            0x1A    ///< Ultralight C AUTHENTICATE (part 1)
+#define NTAG_PAGE_SIZE          4       ///< Bytes per page
+#define NTAG_PAGE_CC            3       ///< Capability container page
+#define NTAG_PAGE_DATA          4       ///< First user data page
+
+#define NDEF_CC_MAGIC           0xE1    ///< CC byte 0: NDEF formatted
+#define NDEF_TLV_NULL           0x00    ///< Padding
+#define NDEF_TLV_MESSAGE        0x03    ///< NDEF message
+#define NDEF_TLV_TERMINATOR     0xFE    ///< Last TLV
+
+/// Pages cached per tag, counted from page 0 (max 32)
+#ifndef CR95HF_NTAG_CACHE_PAGES
+#define CR95HF_NTAG_CACHE_PAGES 16
+#endif
+
+/// Tags with a page cache (least recently used is replaced)
+#ifndef CR95HF_NTAG_CACHE_TAGS
+#define CR95HF_NTAG_CACHE_TAGS  2
+#endif
+
+/// Tags whose identify() result is cached
+#ifndef CR95HF_IDENT_CACHE
+#define CR95HF_IDENT_CACHE      4
+#endif
+
+// ============================================================================
+// CR95HF ISO14443-A Response Trailer
+// Reference: CR95HF Datasheet Section 5.6
+// Every ISO14443-A SendRecv response ends with 3 status bytes:
+// [flags] [collision byte index] [collision bit index]
+// ============================================================================
+
+#define CR95HF_RXFLAG_COLLISION 0x80    ///< Collision detected in response
+#define CR95HF_RXFLAG_CRCERR    0x20    ///< CRC error in response
+#define CR95HF_RXFLAG_PARITYERR 0x10    ///< Parity error in response
+#define CR95HF_RXFLAG_BITS_MASK 0x0F    ///< Significant bits in last byte (0 = 8)
+#define CR95HF_RX_TRAILER_LEN   3       ///< Status bytes appended to tag data
+
+/// Flags that make a tag answer unusable
+#define CR95HF_RXFLAG_ERRORS    (CR95HF_RXFLAG_COLLISION | CR95HF_RXFLAG_CRCERR | CR95HF_RXFLAG_PARITYERR)
+
+/// Largest ISO14443-3 answer accepted (ATQA / UID + BCC / SAK, with trailer)
+#define CR95HF_RX_ISO3_MAX      16
+
+/**
+ * @brief Reply parsed in place in the driver's shared receive buffer
+ *
+ * Valid until the next exchange. For ISO14443-A tag data the trailer is
+ * split off: data[0..len-1] is the tag answer, status its flags byte.
+ */
+struct CR95HF_ResponseView {
+    uint8_t code;           ///< Response code (CR95HF_RSP_*)
+    const uint8_t* data;    ///< Payload (tag data without trailer)
+    uint8_t len;            ///< Payload bytes
+    uint8_t status;         ///< Trailer flags (CR95HF_RXFLAG_*), 0 if none
+
+    /// Tag data of at least minLen bytes, no collision / CRC / parity error
+    bool tagData(uint8_t minLen) const {
+        return code == CR95HF_RSP_DATA && len >= minLen && !(status & CR95HF_RXFLAG_ERRORS);
+    }
+};
+
+// ============================================================================
+// ISO15693 RF Commands
+// Reference: ISO/IEC 15693-3, CR95HF Datasheet Section 5.6
+// SendRecv carries the request bytes only (the CR95HF appends the CRC);
+// responses end with 1 status byte instead of the ISO14443-A trailer.
+// ============================================================================
+
+#define ISO15693_FLAG_HIGH_RATE 0x02    ///< Tag answers at high data rate
+#define ISO15693_FLAG_INVENTORY 0x04    ///< Inventory request
+#define ISO15693_FLAG_1_SLOT    0x20    ///< With INVENTORY: 1 slot (else 16)
+#define ISO15693_FLAG_ADDRESS   0x20    ///< Without INVENTORY: UID follows
+#define ISO15693_FLAG_ERROR     0x01    ///< Response: error code follows
+#define ISO15693_CMD_INVENTORY  0x01    ///< Inventory
+#define ISO15693_CMD_STAY_QUIET 0x02    ///< Stay quiet (addressed)
+#define ISO15693_CMD_READ_MULTI 0x23    ///< Read multiple blocks
+#define ISO15693_UID_LEN        8       ///< UID bytes (LSB first on air)
+#define ISO15693_INVENTORY_RSP_LEN 12   ///< Inventory answer: flags, DSFID, UID, CRC
+#define ISO15693_SLOTS          16      ///< Slots per 16-slot inventory round
+
+/// ProtocolSelect parameter: 26 kbps, single subcarrier, 10% modulation, CRC
+#define CR95HF_ISO15693_PARAM   0x05
+
+/// Status byte ending ISO15693, ISO14443-B and FeliCa responses
+#define CR95HF_RX15_COLLISION   0x01    ///< Status byte: collision
+#define CR95HF_RX15_CRCERR      0x02    ///< Status byte: CRC error
+#define CR95HF_RX15_TRAILER_LEN 1       ///< Status bytes appended to tag data
+
+// ============================================================================
+// ISO14443-B / FeliCa Polling
+// Reference: ISO/IEC 14443-3B, JIS X 6319-4
+// ============================================================================
+
+#define ISO14443B_APF           0x05    ///< REQB / WUPB anticollision prefix
+#define ISO14443B_ATQB          0x50    ///< First byte of ATQB
+#define ISO14443B_ATQB_LEN      12      ///< ATQB: 50, PUPI, app data, protocol info
+#define ISO14443B_PUPI_LEN      4       ///< Pseudo-unique PICC identifier
+#define FELICA_CMD_POLLING      0x00    ///< SENSF_REQ
+#define FELICA_RSP_POLLING      0x01    ///< SENSF_RES
+#define FELICA_IDM_LEN          8       ///< Manufacture ID (IDm)
+#define FELICA_SENSF_RSP_LEN    22      ///< SENSF_RES: LEN, code, IDm, PMm, RD, CRC
+
+/// ProtocolSelect parameter ISO14443-B: 106 kbps, CRC
+#define CR95HF_ISO14443B_PARAM  0x01
+/// ProtocolSelect parameter FeliCa: 212 kbps both ways, CRC
+#define CR95HF_FELICA_PARAM     0x51
+
 // ============================================================================
 // CR95HF SendRecv Flags
 // Reference: CR95HF Datasheet Section 5.6
@@ -120,6 +364,7 @@
 #define CR95HF_TXFLAG_PARITY    0x08    ///< Append odd parity bit (ISO14443A)
 #define CR95HF_TXFLAG_CRC       0x20    ///< Append CRC-A
 #define CR95HF_TXFLAG_TOPAZ     0x80    ///< Topaz format (NFC-T1T)
+#define CR95HF_TXFLAG_BITS_MASK 0x0F    ///< Significant bits in the last byte (1-8)
 
 /// Combined flags: 7-bit short frame, no CRC (for REQA/WUPA)
 #define CR95HF_FLAG_SHORTFRAME  0x07
@@ -145,10 +390,162 @@
 #define SAK_MIFARE_1K_INF       0x88    ///< MIFARE Classic 1K (Infineon)
 #define SAK_MIFARE_PRO          0x98    ///< MIFARE ProX
 
+// ============================================================================
+// CR95HF_Bytes - Frame Byte View
+// ============================================================================
+
+/**
+ * @brief Read-only view of frame bytes (pointer + length)
+ *
+ * Lets sendFrame() take constant frames straight from flash, templated
+ * frames on the stack or a CR95HF_Frame, all without a copy.
+ */
+struct CR95HF_Bytes {
+    const uint8_t* data;    ///< First byte
+    uint8_t len;            ///< Number of bytes
+
+    constexpr CR95HF_Bytes(const uint8_t* d, uint8_t l) : data(d), len(l) {}
+
+    /// View of a whole array; length fixed at compile time
+    template <size_t N>
+    constexpr CR95HF_Bytes(const uint8_t (&a)[N]) : data(a), len(N) {
+        static_assert(N <= 255, "CR95HF frame too long");
+    }
+};
+
+// ============================================================================
+// CR95HF_Frames - Pre-Encoded Fixed Command Frames
+// ============================================================================
+
+/**
+ * @brief Commands that never change, encoded at compile time
+ *
+ * Constant data ends up in flash (.rodata) and is written to the host
+ * interface as is: no per-poll rebuild, no copy into a frame buffer.
+ *
+ * @code
+ * sendFrame(CR95HF_Frames::REQA);
+ * @endcode
+ */
+struct CR95HF_Frames {
+    /// IDN: read device identification
+    static constexpr uint8_t IDN[] = {CR95HF_CMD_IDN, 0x00};
+    /// ProtocolSelect ISO14443-A (106 kbps both ways)
+    static constexpr uint8_t PROTO_ISO14443A[] =
+        {CR95HF_CMD_PROTOCOL, 0x02, CR95HF_PROTO_ISO14443A, 0x00};
+    /// ProtocolSelect ISO15693 (see CR95HF_ISO15693_PARAM)
+    static constexpr uint8_t PROTO_ISO15693[] =
+        {CR95HF_CMD_PROTOCOL, 0x02, CR95HF_PROTO_ISO15693, CR95HF_ISO15693_PARAM};
+    /// ProtocolSelect ISO14443-B
+    static constexpr uint8_t PROTO_ISO14443B[] =
+        {CR95HF_CMD_PROTOCOL, 0x02, CR95HF_PROTO_ISO14443B, CR95HF_ISO14443B_PARAM};
+    /// ProtocolSelect FeliCa
+    static constexpr uint8_t PROTO_FELICA[] =
+        {CR95HF_CMD_PROTOCOL, 0x02, CR95HF_PROTO_FELICA, CR95HF_FELICA_PARAM};
+    /// ProtocolSelect field off
+    static constexpr uint8_t PROTO_OFF[] =
+        {CR95HF_CMD_PROTOCOL, 0x02, CR95HF_PROTO_OFF, 0x00};
+    /// REQA short frame
+    static constexpr uint8_t REQA[] =
+        {CR95HF_CMD_SENDRECV, 0x02, ISO14443A_REQA, CR95HF_FLAG_SHORTFRAME};
+    /// WUPA short frame
+    static constexpr uint8_t WUPA[] =
+        {CR95HF_CMD_SENDRECV, 0x02, ISO14443A_WUPA, CR95HF_FLAG_SHORTFRAME};
+    /// Anticollision, cascade level 1, no UID bits known
+    static constexpr uint8_t ANTICOLL_CL1[] =
+        {CR95HF_CMD_SENDRECV, 0x03, ISO14443A_SEL_CL1, ISO14443A_NVB_ANTICOLL, CR95HF_FLAG_STD};
+    /// Anticollision, cascade level 2, no UID bits known
+    static constexpr uint8_t ANTICOLL_CL2[] =
+        {CR95HF_CMD_SENDRECV, 0x03, ISO14443A_SEL_CL2, ISO14443A_NVB_ANTICOLL, CR95HF_FLAG_STD};
+    /// Anticollision, cascade level 3, no UID bits known
+    static constexpr uint8_t ANTICOLL_CL3[] =
+        {CR95HF_CMD_SENDRECV, 0x03, ISO14443A_SEL_CL3, ISO14443A_NVB_ANTICOLL, CR95HF_FLAG_STD};
+    /// HLTA with CRC
+    static constexpr uint8_t HLTA[] =
+        {CR95HF_CMD_SENDRECV, 0x03, ISO14443A_HLTA_B1, ISO14443A_HLTA_B2, CR95HF_FLAG_STD_CRC};
+};
+
+// ============================================================================
+// CR95HF_SendRecvFrame - Fixed-Length SendRecv Builder
+// ============================================================================
+
+/**
+ * @class   CR95HF_SendRecvFrame
+ * @brief   SendRecv frame with RF payload length known at compile time
+ * @tparam  RF_LEN Number of RF bytes (without the flags byte)
+ *
+ * Frame and length bytes are derived from RF_LEN by the compiler, so there
+ * is no running length or per-byte bounds check.
+ *
+ * @code
+ * static const uint8_t read4[] = {0x30, 0x04};
+ * CR95HF_SendRecvFrame<2> f(read4, CR95HF_FLAG_STD_CRC);
+ * sendFrame(f);
+ * @endcode
+ */
+template <uint8_t RF_LEN>
+class CR95HF_SendRecvFrame {
+public:
+    static_assert(RF_LEN <= 252, "SendRecv payload too long");
+
+    static constexpr uint8_t LEN = RF_LEN + 3;  ///< Command + length + RF + flags
+    uint8_t data[LEN];                          ///< Encoded frame
+
+    /**
+     * @brief Build frame, RF bytes to be filled through rf()
+     * @param flags Transmit flags (CR95HF_FLAG_*)
+     */
+    explicit CR95HF_SendRecvFrame(uint8_t flags) {
+        data[0] = CR95HF_CMD_SENDRECV;
+        data[1] = RF_LEN + 1;
+        data[LEN - 1] = flags;
+    }
+
+    /**
+     * @brief Build frame from RF bytes
+     * @param rfData RF_LEN bytes to transmit
+     * @param flags Transmit flags (CR95HF_FLAG_*)
+     */
+    CR95HF_SendRecvFrame(const uint8_t* rfData, uint8_t flags)
+        : CR95HF_SendRecvFrame(flags) {
+        memcpy(rf(), rfData, RF_LEN);
+    }
+
+    /**
+     * @brief RF payload area
+     */
+    uint8_t* rf() { return &data[2]; }
+
+    operator CR95HF_Bytes() const { return CR95HF_Bytes(data); }
+};
+
+/**
+ * @brief SELECT frame: SEL + NVB 0x70 + 4 UID bytes + BCC, with CRC
+ */
+class CR95HF_SelectFrame : public CR95HF_SendRecvFrame<7> {
+public:
+    /**
+     * @param sel Select code (ISO14443A_SEL_CL1/CL2/CL3)
+     * @param uid4bcc Pointer to 5 bytes: 4 UID bytes + BCC
+     */
+    CR95HF_SelectFrame(uint8_t sel, const uint8_t* uid4bcc)
+        : CR95HF_SendRecvFrame<7>(CR95HF_FLAG_STD_CRC) {
+        data[2] = sel;
+        data[3] = ISO14443A_NVB_SELECT;
+        memcpy(&data[4], uid4bcc, 5);
+    }
+};
+
 // ============================================================================
 // CR95HF_Frame - Frame Builder/Decoder Class
 // ============================================================================
 
+/// CR95HF_Frame capacity; the longest frame built is Idle (16 bytes)
+#ifndef CR95HF_TX_BUFFER
+#define CR95HF_TX_BUFFER        32
+#endif
+static_assert(CR95HF_TX_BUFFER >= 16, "CR95HF_TX_BUFFER must hold an Idle frame");
+
 /**
  * @class   CR95HF_Frame
  * @brief   Frame builder for CR95HF UART protocol commands
@@ -158,6 +555,10 @@
  * - Length (1 byte)
  * - Payload (variable)
  *
+ * The driver itself sends fixed commands from CR95HF_Frames and fixed-size
+ * ones through CR95HF_SendRecvFrame; this class covers frames whose layout
+ * depends on runtime values.
+ *
  * @code
  * CR95HF_Frame frame;
  * frame.buildREQA();
@@ -166,7 +567,7 @@
  */
 class CR95HF_Frame {
 public:
-    uint8_t data[32];   ///< Frame buffer (max 32 bytes)
+    uint8_t data[CR95HF_TX_BUFFER];     ///< Frame buffer
     uint8_t len;        ///< Current frame length
 
     /**
@@ -185,6 +586,11 @@ public:
      */
     void add(uint8_t b) { if (len < sizeof(data)) data[len++] = b; }
 
+    /**
+     * @brief View of the frame bytes (for sendFrame())
+     */
+    operator CR95HF_Bytes() const { return CR95HF_Bytes(data, len); }
+
     /**
      * @brief Build IDN (identification) command
      * @note Response contains device name string (e.g., "NFC FS2JAST4")
@@ -208,6 +614,84 @@ public:
         add(param);
     }
 
+    /**
+     * @brief Build Protocol Select command with frame waiting time
+     * @param proto Protocol code (CR95HF_PROTO_*)
+     * @param param Protocol parameter (ISO14443-A: bit rates)
+     * @param pp FWT exponent
+     * @param mm FWT multiplier - 1
+     * @param dd FWT offset - 128
+     * @note FWT = 2^PP * (MM + 1) * (DD + 128) * 32 / 13.56 MHz
+     */
+    void buildProtocolSelect(uint8_t proto, uint8_t param, uint8_t pp, uint8_t mm, uint8_t dd) {
+        clear();
+        add(CR95HF_CMD_PROTOCOL);
+        add(0x05);  // Payload length
+        add(proto);
+        add(param);
+        add(pp);
+        add(mm);
+        add(dd);
+    }
+
+    /**
+     * @brief Build BaudRate command
+     * @param divider Baud rate divider: baud = 13.56 MHz / (2 * divider + 2)
+     * @note CR95HF answers 0x55 at the new baud rate
+     */
+    void buildBaudRate(uint8_t divider) {
+        clear();
+        add(CR95HF_CMD_BAUDRATE);
+        add(0x01);
+        add(divider);
+    }
+
+    /**
+     * @brief Build WrReg writing ARC_B
+     * @param value Modulation index (bits 7:4) | receiver gain (bits 3:0)
+     */
+    void buildWriteArcB(uint8_t value) {
+        clear();
+        add(CR95HF_CMD_WRREG);
+        add(0x04);
+        add(CR95HF_REG_ARC_INDEX);
+        add(CR95HF_REG_INC_ADDR);
+        add(CR95HF_ARC_B_INDEX);
+        add(value);
+    }
+
+    /**
+     * @brief Build Idle command (low-power mode / tag detector)
+     * @param wuSource Wake-up sources (CR95HF_WU_*)
+     * @param enterCtrl EnterCtrl word (CR95HF_IDLE_ENTER_*)
+     * @param wuCtrl WUCtrl word (CR95HF_IDLE_WU_*)
+     * @param wuPeriod Time between tag detections
+     * @param dacL Tag detector DAC low threshold
+     * @param dacH Tag detector DAC high threshold
+     * @param maxSleep Wake-up periods before timeout
+     * @note Response arrives only on wake-up: 0x00 0x01 <wake-up source>
+     */
+    void buildIdle(uint8_t wuSource, uint16_t enterCtrl, uint16_t wuCtrl,
+                   uint8_t wuPeriod, uint8_t dacL, uint8_t dacH, uint8_t maxSleep) {
+        clear();
+        add(CR95HF_CMD_IDLE);
+        add(0x0E);  // 14 parameter bytes, little-endian words
+        add(wuSource);
+        add(enterCtrl & 0xFF);
+        add(enterCtrl >> 8);
+        add(wuCtrl & 0xFF);
+        add(wuCtrl >> 8);
+        add(CR95HF_IDLE_LEAVE & 0xFF);
+        add(CR95HF_IDLE_LEAVE >> 8);
+        add(wuPeriod);
+        add(CR95HF_IDLE_OSC_START);
+        add(CR95HF_IDLE_DAC_START);
+        add(dacL);
+        add(dacH);
+        add(CR95HF_IDLE_SWINGS);
+        add(maxSleep);
+    }
+
     /**
      * @brief Build SendRecv command with custom RF data
      * @param rfData RF data to transmit
@@ -305,139 +789,1545 @@ public:
         }
         add(CR95HF_FLAG_STD_CRC);
     }
-};
-
-// ============================================================================
-// CR95HF - Main Driver Class
-// ============================================================================
-
-/**
- * @class   CR95HF
- * @brief   Driver for CR95HF NFC/RFID transceiver
- *
- * Provides high-level interface for reading ISO14443-A tags using the
- * CR95HF transceiver over UART.
- *
- * @note    UART must be configured as 8N2 (2 stop bits)
- *
- * @code
- * CR95HF nfc(Serial1, RX_PIN, TX_PIN, 57600);
- *
- * if (nfc.begin()) {
- *     uint8_t uid[10];
- *     uint8_t uidLen, sak;
- *     if (nfc.iso14443aGetUID(uid, uidLen, sak)) {
- *         // Tag detected
- *     }
- * }
- * @endcode
- */
-class CR95HF {
-public:
-    /**
-     * @brief Constructor
-     * @param port HardwareSerial reference (e.g., Serial1)
-     * @param rxPin RX pin number (receives from CR95HF TXD)
-     * @param txPin TX pin number (transmits to CR95HF RXD)
-     * @param baudRate Baud rate (must be 57600 for CR95HF)
-     */
-    CR95HF(HardwareSerial& port, int rxPin, int txPin, uint32_t baudRate);
 
     /**
-     * @brief Initialize the CR95HF
-     * @param debug Enable debug output to Serial (default: false)
-     * @return true if initialization successful, false otherwise
-     *
-     * Performs:
-     * 1. UART initialization (8N2)
-     * 2. Echo test
-     * 3. IDN query
-     * 4. ISO14443-A protocol selection
+     * @brief Build Select command for any cascade level
+     * @param sel Select code (ISO14443A_SEL_CL1/CL2/CL3)
+     * @param uid4bcc Pointer to 5 bytes: 4 UID bytes + BCC
      */
-    bool begin(bool debug = false);
+    void buildSelect(uint8_t sel, const uint8_t* uid4bcc) {
+        clear();
+        add(CR95HF_CMD_SENDRECV);
+        add(0x08);
+        add(sel);
+        add(ISO14443A_NVB_SELECT);
+        for (uint8_t i = 0; i < 5; i++) {
+            add(uid4bcc[i]);
+        }
+        add(CR95HF_FLAG_STD_CRC);
+    }
 
     /**
-     * @brief Read tag UID using ISO14443-A anticollision
-     * @param uid Output buffer for UID (min 10 bytes)
-     * @param uidLen Output: UID length (4, 7, or 10 bytes)
-     * @param sak Output: SAK byte (card type indicator)
-     * @return true if tag detected and UID read, false otherwise
-     *
-     * Automatically handles:
-     * - WUPA/REQA for tag detection
-     * - Multi-level anticollision for 7-byte UIDs
-     * - Cascade tag (0x88) detection
+     * @brief Build bit-oriented Anticollision command
+     * @param sel Select code (ISO14443A_SEL_CL1/CL2/CL3)
+     * @param known UID bits already known (LSB first), at least knownBits
+     * @param knownBits Number of known UID bits (0-39)
+     * @note NVB high nibble = bytes sent incl. SEL and NVB, low nibble = bits
      */
-    bool iso14443aGetUID(uint8_t* uid, uint8_t& uidLen, uint8_t& sak);
+    void buildAnticoll(uint8_t sel, const uint8_t* known, uint8_t knownBits) {
+        uint8_t bytes = knownBits / 8;
+        uint8_t bits = knownBits % 8;
 
-    /**
-     * @brief Read tag UID (without SAK)
-     * @param uid Output buffer for UID (min 10 bytes)
-     * @param uidLen Output: UID length (4, 7, or 10 bytes)
-     * @return true if tag detected and UID read, false otherwise
-     */
-    bool iso14443aGetUID(uint8_t* uid, uint8_t& uidLen);
+        clear();
+        add(CR95HF_CMD_SENDRECV);
+        add(3 + bytes + (bits ? 1 : 0));
+        add(sel);
+        add(((2 + bytes) << 4) | bits);
+        for (uint8_t i = 0; i < bytes; i++) {
+            add(known[i]);
+        }
+        if (bits) {
+            add(known[bytes] & ((1 << bits) - 1));
+        }
+        add(bits ? bits : CR95HF_FLAG_STD);  // Significant bits in last byte
+    }
 
     /**
-     * @brief Get human-readable card type from SAK byte
-     * @param sak SAK byte value
-     * @return Card type string (e.g., "MIFARE Classic 1K")
+     * @brief Build HLTA (Halt Type A) command
+     * @note Tag does not answer; CR95HF reports a timeout
      */
-    const char* getCardType(uint8_t sak);
+    void buildHLTA() {
+        clear();
+        add(CR95HF_CMD_SENDRECV);
+        add(0x03);
+        add(ISO14443A_HLTA_B1);
+        add(ISO14443A_HLTA_B2);
+        add(CR95HF_FLAG_STD_CRC);
+    }
+};
 
-    /**
-     * @brief Run self-test and print results to Serial
-     */
-    void selfTest();
+// ============================================================================
+// Command Statistics
+// ============================================================================
 
-    /**
-     * @brief Read device identification string
-     * @param out Output buffer for IDN string
-     * @param maxLen Maximum buffer length
-     * @return true if successful
-     */
-    bool readIDN(char* out, uint8_t maxLen);
+/// Latency histogram buckets: bucket i counts exchanges < (256 us << i),
+/// the last bucket everything slower
+#define CR95HF_HIST_BUCKETS     8
 
-    /**
-     * @brief Measure RF field level
-     * @param level Output: field level (0-100)
-     * @return true if measurement successful
-     */
-    bool measureFieldLevel(uint8_t& level);
+/**
+ * @brief RF exchange phases with their own latency histogram
+ */
+enum CR95HF_StatPhase : uint8_t {
+    CR95HF_PHASE_WAKE = 0,  ///< REQA / WUPA
+    CR95HF_PHASE_ANTICOLL,  ///< Anticollision (any cascade level)
+    CR95HF_PHASE_SELECT,    ///< Select (any cascade level)
+    CR95HF_PHASE_COUNT      ///< Number of phases
+};
 
-    /**
+/**
+ * @brief Per-command counters and latency histograms
+ *
+ * Updated on every exchange (a few increments, no allocation, no output).
+ * Read with CR95HF::getStats(), clear with CR95HF::resetStats().
+ */
+struct CR95HF_Stats {
+    // Commands sent, by opcode
+    uint32_t cmdIDN;            ///< IDN commands
+    uint32_t cmdProtocol;       ///< ProtocolSelect commands
+    uint32_t cmdSendRecv;       ///< SendRecv commands
+    uint32_t cmdOther;          ///< Any other command
+
+    // Responses, by code
+    uint32_t rspSuccess;        ///< CR95HF_RSP_SUCCESS
+    uint32_t rspData;           ///< CR95HF_RSP_DATA
+    uint32_t rspTimeout;        ///< CR95HF_RSP_TIMEOUT (no tag answer)
+    uint32_t rspCollision;      ///< CR95HF_RSP_COLLISION
+    uint32_t rspFrameErr;       ///< CR95HF_RSP_FRAMEERR
+    uint32_t rspInvalidLen;     ///< CR95HF_RSP_INVALID_LEN
+    uint32_t rspOther;          ///< Any other response code
+
+    // Host-side read timeouts, by response parser phase
+    uint32_t rxTimeoutCode;     ///< Nothing received
+    uint32_t rxTimeoutLen;      ///< Code received, length missing
+    uint32_t rxTimeoutPayload;  ///< Payload incomplete
+
+    // Tag answers rejected by the driver
+    uint32_t rxStatusError;     ///< Collision / CRC / parity flag in the trailer
+    uint32_t rxBccError;        ///< Anticollision UID with a wrong BCC
+
+    /// Command-to-response latency histogram per phase (CR95HF_PHASE_*)
+    uint32_t latency[CR95HF_PHASE_COUNT][CR95HF_HIST_BUCKETS];
+    /// Slowest exchange per phase (us)
+    uint32_t latencyMaxUs[CR95HF_PHASE_COUNT];
+    /// Most recent exchange per phase (us), for exact percentiles
+    uint32_t latencyLastUs[CR95HF_PHASE_COUNT];
+};
+
+// ============================================================================
+// Response Timeouts
+// Host-side wait for a CR95HF reply: command and full response buffer over
+// the link at the current baud rate, plus a fixed margin. ISO14443-A
+// exchanges add the default frame wait time, or learn their timeout from
+// observed latencies (setAdaptiveTimeouts()).
+// ============================================================================
+
+/// Chip processing and host scheduling margin of every reply (ms)
+#ifndef CR95HF_TMO_MARGIN_MS
+#define CR95HF_TMO_MARGIN_MS    4
+#endif
+
+/// Default ISO14443-A frame wait time, rounded up (ms)
+#define CR95HF_TMO_RF_MS        1
+
+/// Ceiling of a learned ISO14443-A reply timeout (ms)
+#ifndef CR95HF_TMO_MAX_MS
+#define CR95HF_TMO_MAX_MS       50
+#endif
+
+/// Learned latency decay: 1/2^N of the gap per faster reply
+#define CR95HF_TMO_DECAY_SHIFT  4
+
+/// ISO14443-A air time per byte at 106 kbit/s: 9 bits with parity (us)
+#define CR95HF_RF_BYTE_US_A     85
+/// ISO14443-A per-frame air time: SoF / EoF and the tag's frame delay (us)
+#define CR95HF_RF_FRAME_US_A    100
+
+/// ISO15693 air time per byte at 26 kbit/s (us)
+#define CR95HF_RF_BYTE_US_15693     302
+/// ISO15693 per-frame air time: SOF / EOF and the tag's response delay t1 (us)
+#define CR95HF_RF_FRAME_US_15693    650
+
+/// ISO14443-B air time per byte at 106 kbit/s: 10 bits with start / stop (us)
+#define CR95HF_RF_BYTE_US_B     95
+/// ISO14443-B per-frame air time: SOF / EOF and TR0 / TR1 (us)
+#define CR95HF_RF_FRAME_US_B    500
+
+/// FeliCa air time per byte at 212 kbit/s (us)
+#define CR95HF_RF_BYTE_US_F     38
+/// FeliCa per-frame air time: preamble, sync and the slot 0 response time (us)
+#define CR95HF_RF_FRAME_US_F    2700
+
+// ============================================================================
+// Wake Strategy
+// ============================================================================
+
+/**
+ * @brief ISO14443-A wake-up command used by the UID reads
+ */
+enum CR95HF_WakeStrategy : uint8_t {
+    CR95HF_WAKE_WUPA = 0,   ///< WUPA (also wakes halted tags), REQA after a garbled answer
+    CR95HF_WAKE_REQA,       ///< REQA only: halted tags stay silent until they leave
+    CR95HF_WAKE_ALTERNATE   ///< WUPA and REQA on alternate polls
+};
+
+// ============================================================================
+// Warm Start
+// ============================================================================
+
+/// CR95HF_WarmState::magic of a saved state
+#define CR95HF_WARM_MAGIC       0x43523935UL    // "CR95"
+
+/**
+ * @brief Driver state kept across MCU deep sleep (e.g. RTC_DATA_ATTR)
+ *
+ * Filled by CR95HF::saveWarmState(), consumed by CR95HF::beginFast().
+ * Only valid while the CR95HF itself stays powered.
+ */
+struct CR95HF_WarmState {
+    uint32_t magic;         ///< CR95HF_WARM_MAGIC when valid
+    uint32_t baud;          ///< Link baud rate the CR95HF runs at
+    char deviceName[20];    ///< IDN string read by begin()
+    uint8_t proto;          ///< Protocol selected when saved (field on if not OFF)
+    uint8_t arcB;           ///< ISO14443-A ARC_B override (0 = default)
+    uint8_t tdRef;          ///< Tag detector DAC reference
+    uint8_t tdGuard;        ///< Tag detector window half-width
+    bool tdValid;           ///< Tag detector reference set
+};
+
+// ============================================================================
+// Asynchronous UID Read
+// ============================================================================
+
+/**
+ * @brief Status returned by CR95HF::poll()
+ */
+enum CR95HF_AsyncStatus : uint8_t {
+    CR95HF_ASYNC_IDLE = 0,  ///< No operation started
+    CR95HF_ASYNC_BUSY,      ///< Exchange in progress, call poll() again
+    CR95HF_ASYNC_DONE,      ///< UID read, result is valid
+    CR95HF_ASYNC_NO_TAG,    ///< No tag answered WUPA/REQA
+    CR95HF_ASYNC_ERROR      ///< Anticollision or select failed
+};
+
+/**
+ * @brief Result of an asynchronous UID read
+ */
+struct CR95HF_UIDResult {
+    uint8_t uid[10];        ///< Tag UID
+    uint8_t uidLen;         ///< UID length (4, 7 or 10 bytes)
+    uint8_t sak;            ///< SAK byte (card type indicator)
+    uint8_t atqa[2];        ///< ATQA bytes
+};
+
+/**
+ * @brief Answer To Select of an ISO14443-4 card (see isoDepActivate())
+ */
+struct CR95HF_ATS {
+    uint8_t data[CR95HF_ATS_MAX];   ///< Raw ATS, TL first (CRC removed)
+    uint8_t len;            ///< Bytes in data
+    uint16_t fsc;           ///< Largest frame the card accepts (FSC)
+    uint8_t fwi;            ///< Frame waiting time integer (FWT = 302 us * 2^FWI)
+    uint8_t sfgi;           ///< Start-up frame guard time integer
+    uint8_t ta;             ///< TA(1) bit rate capability (0 = 106 kbps only)
+    uint8_t histOffset;     ///< Index of the first historical byte in data
+};
+
+/**
+ * @brief Page cache of one NTAG / Ultralight tag
+ */
+struct CR95HF_PageCache {
+    uint8_t uid[10];        ///< Tag UID
+    uint8_t uidLen;         ///< UID length (0 = entry unused)
+    bool fastRead;          ///< Tag accepts FAST_READ (cleared after a NAK)
+    uint32_t valid;         ///< Bit n set: page n cached
+    uint32_t used;          ///< millis() of last use
+    uint8_t data[CR95HF_NTAG_CACHE_PAGES * NTAG_PAGE_SIZE];  ///< Cached pages
+};
+
+/**
+ * @brief Exact tag model (see identify())
+ */
+enum CR95HF_TagModel : uint8_t {
+    CR95HF_MODEL_UNKNOWN = 0,       ///< Not identified
+    CR95HF_MODEL_TYPE2,             ///< Other Type 2 tag with GET_VERSION
+    CR95HF_MODEL_ULTRALIGHT,        ///< MIFARE Ultralight (no GET_VERSION)
+    CR95HF_MODEL_ULTRALIGHT_C,      ///< MIFARE Ultralight C
+    CR95HF_MODEL_ULTRALIGHT_EV1_48, ///< MIFARE Ultralight EV1 MF0UL11
+    CR95HF_MODEL_ULTRALIGHT_EV1_128,///< MIFARE Ultralight EV1 MF0UL21
+    CR95HF_MODEL_NTAG210,           ///< NTAG210
+    CR95HF_MODEL_NTAG212,           ///< NTAG212
+    CR95HF_MODEL_NTAG213,           ///< NTAG213
+    CR95HF_MODEL_NTAG215,           ///< NTAG215
+    CR95HF_MODEL_NTAG216,           ///< NTAG216
+    CR95HF_MODEL_NTAG_I2C_1K,       ///< NTAG I2C (plus) 1k
+    CR95HF_MODEL_NTAG_I2C_2K,       ///< NTAG I2C (plus) 2k
+    CR95HF_MODEL_CLASSIC_MINI,      ///< MIFARE Classic Mini
+    CR95HF_MODEL_CLASSIC_1K,        ///< MIFARE Classic 1K
+    CR95HF_MODEL_CLASSIC_4K,        ///< MIFARE Classic 4K
+    CR95HF_MODEL_DESFIRE,           ///< MIFARE DESFire (EV0)
+    CR95HF_MODEL_DESFIRE_EV1,       ///< MIFARE DESFire EV1
+    CR95HF_MODEL_DESFIRE_EV2,       ///< MIFARE DESFire EV2
+    CR95HF_MODEL_DESFIRE_EV3,       ///< MIFARE DESFire EV3
+    CR95HF_MODEL_ISO_DEP            ///< Other ISO14443-4 card (JCOP, ...)
+};
+
+/**
+ * @brief Result of identify()
+ */
+struct CR95HF_TagInfo {
+    uint8_t model;          ///< CR95HF_TagModel
+    uint16_t memorySize;    ///< User memory in bytes (0 = unknown)
+    uint8_t version[8];     ///< Raw GET_VERSION answer
+    uint8_t versionLen;     ///< Bytes in version (0 = none)
+};
+
+/**
+ * @brief One ISO15693 tag found by iso15693Inventory()
+ */
+struct CR95HF_VicinityTag {
+    uint8_t uid[ISO15693_UID_LEN];  ///< UID, LSB first as on air (uid[7] = 0xE0)
+    uint8_t dsfid;                  ///< Data storage format identifier
+};
+
+// ============================================================================
+// Tag Tracking (Enter / Leave Events)
+// ============================================================================
+
+/// Number of tags tracked at once by track()
+#ifndef CR95HF_TRACK_CAPACITY
+#define CR95HF_TRACK_CAPACITY 4
+#endif
+
+/**
+ * @brief Callback for tag enter/leave events
+ */
+typedef std::function<void(const CR95HF_UIDResult& tag)> CR95HF_TagCallback;
+
+/**
+ * @brief Tag tracking cache entry
+ */
+struct CR95HF_TrackedTag {
+    CR95HF_UIDResult tag;   ///< UID and SAK as first read
+    uint32_t lastSeen;      ///< millis() of last successful presence check
+    uint8_t misses;         ///< Consecutive failed presence checks
+    bool used;              ///< Entry in use
+};
+
+// ============================================================================
+// Background Reader Task
+// ============================================================================
+
+/// Tag event queue capacity (must be a power of two)
+#ifndef CR95HF_EVENT_QUEUE_SIZE
+#define CR95HF_EVENT_QUEUE_SIZE 8
+#endif
+
+/**
+ * @brief Tag detection record published by the background reader task
+ */
+struct CR95HF_TagEvent {
+    uint8_t uid[10];        ///< Tag UID
+    uint8_t uidLen;         ///< UID length (4, 7 or 10 bytes)
+    uint8_t sak;            ///< SAK byte (card type indicator)
+    uint8_t atqa[2];        ///< ATQA bytes
+    uint32_t timestamp;     ///< millis() at detection
+};
+
+// ============================================================================
+// Continuous Scan
+// ============================================================================
+
+/// Tag records per continuous-scan batch (RAM: one CR95HF_TagEvent each)
+#ifndef CR95HF_SCAN_BATCH_MAX
+#define CR95HF_SCAN_BATCH_MAX   8
+#endif
+
+/**
+ * @brief Settings of CR95HF::startContinuousScan()
+ */
+struct CR95HF_ScanConfig {
+    uint32_t periodMs = 150;        ///< Poll cadence (ms)
+    uint8_t retries = 1;            ///< Immediate re-reads after a tag answered but the read failed
+    uint8_t batchSize = CR95HF_SCAN_BATCH_MAX;  ///< Deliver once this many records are held
+    uint32_t batchMs = 1000;        ///< ...or this long after the first held record (0 = size only)
+    bool dedupe = true;             ///< A UID already in the batch is not added again
+    BaseType_t core = 0;            ///< CPU core of the scan task
+    UBaseType_t priority = 2;       ///< FreeRTOS priority of the scan task
+    uint32_t stackSize = 4096;      ///< Scan task stack (bytes), callback included
+};
+
+/**
+ * @brief Batch callback of the continuous scan
+ * @param tags Records in detection order (valid during the call only)
+ * @param count Number of records (1..batchSize)
+ */
+typedef std::function<void(const CR95HF_TagEvent* tags, uint8_t count)> CR95HF_ScanCallback;
+
+/**
+ * @class   CR95HF_EventQueue
+ * @brief   Fixed-size lock-free single-producer/single-consumer ring buffer
+ * @tparam  T Element type (trivially copyable)
+ * @tparam  N Capacity, must be a power of two
+ *
+ * push() must only be called from one task and pop() from one other task.
+ * Indices are free-running; one slot is never wasted.
+ */
+template <typename T, uint16_t N>
+class CR95HF_EventQueue {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "Queue size must be a power of two");
+
+public:
+    CR95HF_EventQueue() : _head(0), _tail(0) {}
+
+    /**
+     * @brief Append element (producer side)
+     * @return false if queue is full (element dropped)
+     */
+    bool push(const T& item) {
+        uint16_t head = _head.load(std::memory_order_relaxed);
+        if ((uint16_t)(head - _tail.load(std::memory_order_acquire)) >= N) return false;
+        _buf[head & (N - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove oldest element (consumer side)
+     * @return false if queue is empty
+     */
+    bool pop(T& item) {
+        uint16_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) return false;
+        item = _buf[tail & (N - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Number of queued elements
+     */
+    uint16_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+private:
+    T _buf[N];
+    std::atomic<uint16_t> _head;    ///< Next write index (producer)
+    std::atomic<uint16_t> _tail;    ///< Next read index (consumer)
+};
+
+// ============================================================================
+// Deferred Debug Log
+// ============================================================================
+
+/// Deferred debug log ring buffer size in bytes (power of two)
+#ifndef CR95HF_LOG_SIZE
+#define CR95HF_LOG_SIZE 1024
+#endif
+
+/**
+ * @brief Debug log record types
+ */
+enum CR95HF_LogType : uint8_t {
+    CR95HF_LOG_MSG = 0,     ///< Constant message (pointer only)
+    CR95HF_LOG_VALUE,       ///< Constant format + one uint32_t argument
+    CR95HF_LOG_TX,          ///< Frame sent to the CR95HF
+    CR95HF_LOG_RX           ///< Response: code + payload
+};
+
+/**
+ * @brief Debug log record header (payload bytes follow in the ring)
+ */
+struct CR95HF_LogHeader {
+    uint32_t us;            ///< micros() when logged
+    uint8_t type;           ///< CR95HF_LogType
+    uint8_t len;            ///< Payload length
+};
+
+/**
+ * @class   CR95HF_LogRing
+ * @brief   Lock-free single-producer/single-consumer byte ring for log records
+ *
+ * A record is a CR95HF_LogHeader plus up to 255 payload bytes. push() is
+ * two memcpy at most; if the record does not fit it is dropped and counted.
+ * Messages are stored as pointers to their constant strings, so only frame
+ * bytes are ever copied.
+ */
+class CR95HF_LogRing {
+    static_assert(CR95HF_LOG_SIZE >= 64 && (CR95HF_LOG_SIZE & (CR95HF_LOG_SIZE - 1)) == 0,
+                  "Log size must be a power of two");
+
+public:
+    CR95HF_LogRing() : _head(0), _tail(0), _dropped(0) {}
+
+    /**
+     * @brief Append a record made of two byte ranges (producer side)
+     * @return false if the ring is full (record dropped)
+     */
+    bool push(uint8_t type, const void* a, uint8_t aLen, const void* b, uint8_t bLen) {
+        uint16_t len = aLen + bLen;
+        if (len > 255) {
+            bLen = 255 - aLen;
+            len = 255;
+        }
+
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        uint32_t used = head - _tail.load(std::memory_order_acquire);
+        if (used + sizeof(CR95HF_LogHeader) + len > CR95HF_LOG_SIZE) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        CR95HF_LogHeader h = { (uint32_t)micros(), type, (uint8_t)len };
+        head = copyIn(head, &h, sizeof(h));
+        head = copyIn(head, a, aLen);
+        head = copyIn(head, b, bLen);
+        _head.store(head, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove oldest record (consumer side)
+     * @param h Output: header
+     * @param payload Output: payload (at least 255 bytes)
+     * @return false if the ring is empty
+     */
+    bool pop(CR95HF_LogHeader& h, uint8_t* payload) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) return false;
+        tail = copyOut(tail, &h, sizeof(h));
+        tail = copyOut(tail, payload, h.len);
+        _tail.store(tail, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Records dropped because the ring was full
+     */
+    uint32_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+    uint8_t _buf[CR95HF_LOG_SIZE];
+    std::atomic<uint32_t> _head;    ///< Next write offset (producer)
+    std::atomic<uint32_t> _tail;    ///< Next read offset (consumer)
+    std::atomic<uint32_t> _dropped; ///< Records lost to a full ring
+
+    uint32_t copyIn(uint32_t pos, const void* src, uint16_t n) {
+        const uint8_t* s = static_cast<const uint8_t*>(src);
+        uint16_t off = pos & (CR95HF_LOG_SIZE - 1);
+        uint16_t first = (n < CR95HF_LOG_SIZE - off) ? n : CR95HF_LOG_SIZE - off;
+        memcpy(&_buf[off], s, first);
+        memcpy(_buf, s + first, n - first);
+        return pos + n;
+    }
+
+    uint32_t copyOut(uint32_t pos, void* dst, uint16_t n) {
+        uint8_t* d = static_cast<uint8_t*>(dst);
+        uint16_t off = pos & (CR95HF_LOG_SIZE - 1);
+        uint16_t first = (n < CR95HF_LOG_SIZE - off) ? n : CR95HF_LOG_SIZE - off;
+        memcpy(d, &_buf[off], first);
+        memcpy(d + first, _buf, n - first);
+        return pos + n;
+    }
+};
+
+// ============================================================================
+// CR95HF - Main Driver Class
+// ============================================================================
+
+/**
+ * @class   CR95HF
+ * @brief   Driver for CR95HF NFC/RFID transceiver
+ *
+ * Provides high-level interface for reading ISO14443-A tags using the
+ * CR95HF transceiver over UART, or over any CR95HF_Transport (e.g. SPI).
+ *
+ * @note    UART must be configured as 8N2 (2 stop bits)
+ *
+ * @code
+ * CR95HF nfc(Serial1, RX_PIN, TX_PIN, 57600);
+ * // or: CR95HF_SpiTransport spi(SPI2_HOST, SCK, MISO, MOSI, CS, IRQ_IN, IRQ_OUT);
+ * //     CR95HF nfc(spi);
+ *
+ * if (nfc.begin()) {
+ *     uint8_t uid[10];
+ *     uint8_t uidLen, sak;
+ *     if (nfc.iso14443aGetUID(uid, uidLen, sak)) {
+ *         // Tag detected
+ *     }
+ * }
+ * @endcode
+ */
+class CR95HF {
+public:
+    /**
+     * @brief Constructor
+     * @param port HardwareSerial reference (e.g., Serial1)
+     * @param rxPin RX pin number (receives from CR95HF TXD)
+     * @param txPin TX pin number (transmits to CR95HF RXD)
+     * @param baudRate Baud rate (must be 57600 for CR95HF)
+     */
+    CR95HF(HardwareSerial& port, int rxPin, int txPin, uint32_t baudRate);
+
+    /**
+     * @brief Constructor for a custom host interface
+     * @param transport Transport instance (must outlive the driver)
+     */
+    explicit CR95HF(CR95HF_Transport& transport);
+
+    /// Destroys the built-in UART transport; an injected one is left alone
+    ~CR95HF();
+
+    /// Not copyable: the built-in UART transport lives inside the object
+    CR95HF(const CR95HF&) = delete;
+    CR95HF& operator=(const CR95HF&) = delete;
+
+    /**
+     * @brief Initialize the CR95HF
+     * @param debug Enable debug output to Serial (default: false)
+     * @param targetBaud Baud rate to switch to after init (0 = keep)
+     * @return true if initialization successful, false otherwise
+     *
+     * Performs:
+     * 1. Transport initialization (UART: 8N2)
+     * 2. Echo test
+     * 3. IDN query
+     * 4. ISO14443-A protocol selection
+     * 5. Optional switch to targetBaud (see setBaudRate())
+     *
+     * A failed baud-rate switch is not an error: the link stays at the
+     * constructor baud rate. If the first echo fails and targetBaud is set,
+     * targetBaud is tried too, in case the CR95HF kept it across an MCU reset.
+     */
+    bool begin(bool debug = false, uint32_t targetBaud = 0);
+
+    /**
+     * @brief Initialize from a state saved before deep sleep
+     * @param state State from saveWarmState() (invalid magic: full begin())
+     * @param debug Enable debug output to Serial
+     * @return true if initialization successful
+     *
+     * One echo at the saved baud rate and one ISO14443-A ProtocolSelect
+     * (plus ARC_B if set). The device name, ARC_B and tag detector
+     * calibration come from the saved state. The IDN check runs later,
+     * after the first poll that finds no tag (blocking or startGetUID()
+     * / poll()). If the echo fails, the
+     * CR95HF lost its state and a full begin() runs instead.
+     */
+    bool beginFast(const CR95HF_WarmState& state, bool debug = false);
+
+    /**
+     * @brief Save the state beginFast() needs (call before deep sleep)
+     * @param state Output, typically in RTC memory
+     */
+    void saveWarmState(CR95HF_WarmState& state) const;
+
+    /**
+     * @brief Deferred IDN check of beginFast() not yet run
+     */
+    bool warmCheckPending() const { return _idnPending; }
+
+    /**
+     * @brief Switch CR95HF and host UART to a new baud rate
+     * @param baud Requested baud rate (e.g. 115200, 230400)
+     * @return true if link verified at the new rate
+     *
+     * Sends the BaudRate command, reconfigures the serial port and runs
+     * echoTest(). If the echo fails, the previous rate is restored on both
+     * sides. The actual rate is 13.56 MHz / (2 * n + 2) and is rejected if
+     * more than 3% away from the request.
+     *
+     * @note The CR95HF returns to 57600 baud on power-up
+     * @note UART transport only - returns false on other transports
+     */
+    bool setBaudRate(uint32_t baud);
+
+    /**
+     * @brief Get current UART baud rate (0 on non-UART transports)
+     */
+    uint32_t getBaudRate() const { return _link->baudRate(); }
+
+    /**
+     * @brief Enable event-driven receive
+     * @param enable true to block on RX events, false to spin-poll (default)
+     * @return true if mode applied
+     *
+     * When enabled, waiting for a response blocks the calling task on a
+     * semaphore given from the UART RX-timeout event (HardwareSerial
+     * onReceive), so the CPU is free during RF exchanges. The event fires
+     * when the line goes idle, i.e. once per CR95HF frame. The SPI transport
+     * blocks on the IRQ_OUT falling edge instead.
+     *
+     * @note Call after begin() - the transport must already be running
+     */
+    bool setRxEvents(bool enable = true);
+
+    /**
+     * @brief Read tag UID using ISO14443-A anticollision
+     * @param uid Output buffer for UID (min 10 bytes)
+     * @param uidLen Output: UID length (4, 7, or 10 bytes)
+     * @param sak Output: SAK byte (card type indicator)
+     * @return true if tag detected and UID read, false otherwise
+     *
+     * Automatically handles:
+     * - WUPA/REQA for tag detection
+     * - Multi-level anticollision for 7-byte and 10-byte UIDs
+     * - Cascade tag (0x88) detection
+     */
+    bool iso14443aGetUID(uint8_t* uid, uint8_t& uidLen, uint8_t& sak);
+
+    /**
+     * @brief Read tag UID (without SAK)
+     * @param uid Output buffer for UID (min 10 bytes)
+     * @param uidLen Output: UID length (4, 7, or 10 bytes)
+     * @return true if tag detected and UID read, false otherwise
+     */
+    bool iso14443aGetUID(uint8_t* uid, uint8_t& uidLen);
+
+    /**
+     * @brief Select the wake-up command of the UID reads
+     * @param strategy CR95HF_WAKE_WUPA (default), _REQA or _ALTERNATE
+     */
+    void setWakeStrategy(CR95HF_WakeStrategy strategy) { _wakeStrategy = strategy; }
+
+    /**
+     * @brief Wake-up strategy in use
+     */
+    CR95HF_WakeStrategy getWakeStrategy() const { return _wakeStrategy; }
+
+    /**
+     * @brief Empty-field check in one exchange
+     * @return true if no tag answered the wake-up command
+     *
+     * Sends one WUPA / REQA (per the wake strategy). When a tag answers it
+     * is left READY: an iso14443aGetUID() or startGetUID() issued next
+     * continues from its ATQA instead of waking it again.
+     */
+    bool fieldIsEmpty();
+
+    /**
+     * @brief Start a non-blocking UID read
+     * @return true if started, false if another read is still in progress
+     *
+     * Sends the first command and returns immediately: ProtocolSelect
+     * when another protocol or ISO-DEP settings are active, else WUPA.
+     * Call poll() until it returns something other than
+     * CR95HF_ASYNC_BUSY. Do not call blocking methods while a read is
+     * in progress - they share the serial port.
+     *
+     * @code
+     * nfc.startGetUID();
+     * // ... in loop():
+     * CR95HF_UIDResult res;
+     * if (nfc.poll(res) == CR95HF_ASYNC_DONE) {
+     *     // res.uid / res.uidLen / res.sak valid
+     * }
+     * @endcode
+     */
+    bool startGetUID();
+
+    /**
+     * @brief Advance the non-blocking UID read
+     * @param result Output: filled in when CR95HF_ASYNC_DONE is returned
+     * @return Current status (see CR95HF_AsyncStatus)
+     *
+     * Consumes whatever bytes are already buffered by the UART and sends
+     * the next command when a response is complete. Never waits. Before
+     * CR95HF_ASYNC_NO_TAG is returned, the IDN check of beginFast() runs
+     * if still pending and, with setFieldDutyCycle() on, the empty field
+     * is switched off (PROTO_OFF).
+     */
+    CR95HF_AsyncStatus poll(CR95HF_UIDResult& result);
+
+    /**
+     * @brief Abort a non-blocking UID read in progress
+     */
+    void cancel();
+
+    /**
+     * @brief Check if a non-blocking UID read is in progress
+     * @return true while poll() would return CR95HF_ASYNC_BUSY
+     */
+    bool busy() const { return _asyncStep != ASYNC_IDLE; }
+
+    /**
+     * @brief Start background reader task
+     * @param periodMs Poll period in milliseconds
+     * @param core CPU core to pin the task to
+     * @param priority FreeRTOS task priority
+     * @param stackSize Task stack size in bytes
+     * @return true if task started
+     *
+     * The task runs iso14443aGetUID() at a fixed cadence and publishes each
+     * detection to a lock-free queue drained with readTagEvent(). While the
+     * task runs, no other driver method may be called from other tasks.
+     * startContinuousScan() runs the same task with batched callbacks.
+     *
+     * @note Combine with setRxEvents() so the task sleeps during exchanges
+     */
+    bool startTask(uint32_t periodMs = 150, BaseType_t core = 0,
+                   UBaseType_t priority = 2, uint32_t stackSize = 4096);
+
+    /**
+     * @brief Stop background reader task (waits for current poll to end)
+     */
+    void stopTask();
+
+    /**
+     * @brief Check if background reader task is running
+     */
+    bool taskRunning() const { return _task != NULL; }
+
+    /**
+     * @brief Start the background task in batched-callback mode
+     * @param config Cadence, retries, batching and task settings
+     * @param callback Called from the scan task with each batch
+     * @return false if a background task already runs or config is invalid
+     *
+     * The driver owns the loop: it polls every config.periodMs, re-reads at
+     * once when a tag answered but the read failed (up to config.retries
+     * times), and collects the reads. A batch is delivered in one callback
+     * when it holds config.batchSize records or config.batchMs after its
+     * first record (checked once per poll), and when the scan stops. An
+     * empty field never calls back. Keep the callback short or hand the
+     * records off: it delays the next poll, not the cadence after it. The
+     * callback may call stopContinuousScan(); the scan then ends when it
+     * returns, and the records still held are delivered first.
+     */
+    bool startContinuousScan(const CR95HF_ScanConfig& config, CR95HF_ScanCallback callback);
+
+    /**
+     * @brief Stop the continuous scan; the pending batch is delivered first
+     */
+    void stopContinuousScan();
+
+    /**
+     * @brief Batches delivered since startContinuousScan()
+     */
+    uint32_t scanBatches() const { return _scanBatches; }
+
+    /**
+     * @brief Re-reads made after failed reads since startContinuousScan()
+     */
+    uint32_t scanRetries() const { return _scanRetries; }
+
+    /**
+     * @brief Fetch next tag event from the background task
+     * @param ev Output: oldest queued event
+     * @return true if an event was available
+     */
+    bool readTagEvent(CR95HF_TagEvent& ev) { return _events.pop(ev); }
+
+    /**
+     * @brief Number of tag events waiting in the queue
+     */
+    uint16_t tagEventsAvailable() const { return _events.size(); }
+
+    /**
+     * @brief Number of tag events dropped because the queue was full
+     */
+    uint32_t tagEventsDropped() const { return _eventsDropped; }
+
+    /**
+     * @brief Read every ISO14443-A tag in the field
+     * @param tags Output array of UID results
+     * @param maxTags Capacity of tags
+     * @return Number of tags found
+     *
+     * Walks the binary anticollision tree: when tags collide, the reported
+     * collision bit is fixed to 1 and anticollision resumes from that bit
+     * instead of restarting. Each resolved tag is selected and halted (HLTA),
+     * so the next REQA only wakes the remaining ones.
+     *
+     * The RF field is reset first (about 2 x CR95HF_FIELD_RESET_MS): a tag
+     * woken from HALT by WUPA falls back to HALT as soon as another tag is
+     * selected, so tags halted earlier could otherwise only be found one
+     * per call.
+     *
+     * @note Tags are left halted; they answer again after WUPA or when
+     *       re-entering the field.
+     */
+    uint8_t inventory(CR95HF_UIDResult* tags, uint8_t maxTags);
+
+    /**
+     * @brief Send HLTA to the currently selected tag
+     * @return true if command was processed by the CR95HF
+     */
+    bool halt();
+
+    /**
+     * @brief Check that an already-read tag is still in the field
+     * @param uid Cached UID (from iso14443aGetUID() or poll())
+     * @param uidLen UID length (4, 7 or 10)
+     * @return true if that exact tag answered
+     *
+     * Skips anticollision: WUPA, then SELECT directly with the cached
+     * UID + BCC per cascade level, then HLTA. Halting lets the next check's
+     * WUPA be answered right away (a selected tag ignores WUPA and drops to
+     * IDLE, which would cost a second probe).
+     * Round trips: 3 for 4-byte, 4 for 7-byte, 5 for 10-byte UIDs, instead
+     * of up to 6-9.
+     */
+    bool isStillPresent(const uint8_t* uid, uint8_t uidLen);
+
+    /**
+     * @brief Run one tracking cycle and fire enter/leave callbacks
+     * @return Number of tags currently tracked (present)
+     *
+     * Known tags are confirmed with isStillPresent(), which leaves them
+     * halted. A single REQA then only wakes tags that are not tracked yet:
+     * full anticollision runs only when it gets an answer. With an empty
+     * field and nothing tracked, a cycle is one WUPA.
+     *
+     * A tag is reported as left only after missTolerance consecutive misses
+     * AND holdOffMs without a successful check (see setTrackingWindow()), so
+     * a card held at the edge of the field does not flicker.
+     *
+     * @code
+     * nfc.onTagEnter([](const CR95HF_UIDResult& t) { ... });
+     * nfc.onTagLeave([](const CR95HF_UIDResult& t) { ... });
+     * void loop() { nfc.track(); delay(50); }
+     * @endcode
+     */
+    uint8_t track();
+
+    /**
+     * @brief Set callback for a tag entering the field
+     */
+    void onTagEnter(CR95HF_TagCallback cb) { _onEnter = cb; }
+
+    /**
+     * @brief Set callback for a tag leaving the field
+     */
+    void onTagLeave(CR95HF_TagCallback cb) { _onLeave = cb; }
+
+    /**
+     * @brief Configure leave debouncing
+     * @param holdOffMs Minimum time without a successful check (default 300)
+     * @param missTolerance Consecutive misses tolerated (default 2)
+     */
+    void setTrackingWindow(uint32_t holdOffMs, uint8_t missTolerance) {
+        _trackHoldOff = holdOffMs;
+        _trackMisses = missTolerance;
+    }
+
+    /**
+     * @brief Number of tags currently tracked
+     */
+    uint8_t trackedCount() const;
+
+    /**
+     * @brief Forget all tracked tags (no leave events)
+     */
+    void clearTracking() { memset(_tracked, 0, sizeof(_tracked)); }
+
+    /**
+     * @brief Raw RF exchange with the selected tag (CRC added and checked)
+     * @param tx RF bytes to send (without CRC)
+     * @param txLen Number of bytes (max CR95HF_RF_BUFFER - 4)
+     * @param rx Output: tag answer (without CRC and status bytes)
+     * @param rxLen Input: capacity, Output: answer length
+     * @param timeoutMs Host-side timeout
+     * @return true if the tag answered with a correct CRC
+     *
+     * For tag commands the driver has no method for (READ, WRITE, ...).
+     */
+    bool transceive(const uint8_t* tx, uint8_t txLen, uint8_t* rx, uint8_t& rxLen,
+                    uint32_t timeoutMs = 20);
+
+    /**
+     * @brief Enter ISO14443-4 (ISO-DEP) on the selected tag: RATS, opt. PPS
+     * @param ats Output: parsed ATS (may be NULL)
+     * @param highSpeed Negotiate the fastest bit rate both sides support
+     *        (up to 424 kbps) with PPS
+     * @return true if the card answered RATS
+     *
+     * Call right after iso14443aGetUID() found a tag with SAK bit 0x20 set
+     * (DESFire, JCOP, ...). Frame size (FSC) and waiting time (FWT) from the
+     * ATS are applied to transceiveAPDU(). The next WUPA/REQA returns the
+     * CR95HF to 106 kbps ISO14443-3 settings.
+     */
+    bool isoDepActivate(CR95HF_ATS* ats = NULL, bool highSpeed = false);
+
+    /**
+     * @brief Change bit rates with PPS (only directly after isoDepActivate())
+     * @param dsi Card to reader divisor integer (0 = 106, 1 = 212, 2 = 424 kbps)
+     * @param dri Reader to card divisor integer (same encoding)
+     * @return true if the card confirmed and the CR95HF switched
+     */
+    bool isoDepPPS(uint8_t dsi, uint8_t dri);
+
+    /**
+     * @brief Exchange an APDU with the ISO-DEP card
+     * @param cmd Command APDU
+     * @param cmdLen Command length (any size, chained in FSC-sized blocks)
+     * @param resp Output: response APDU including SW1 SW2
+     * @param respLen Input: capacity, Output: response length
+     * @return true on success (false on timeout, protocol error or overflow)
+     *
+     * Handles I-block chaining in both directions, R(ACK)/R(NAK) recovery
+     * and waiting time extensions, so APDUs far beyond the CR95HF 256-byte
+     * frame limit stream through in chunks.
+     *
+     * @code
+     * static const uint8_t selectPpse[] = {0x00, 0xA4, 0x04, 0x00, 0x0E,
+     *     '2','P','A','Y','.','S','Y','S','.','D','D','F','0','1', 0x00};
+     * uint8_t resp[256];
+     * uint16_t respLen = sizeof(resp);
+     * if (nfc.isoDepActivate() && nfc.transceiveAPDU(selectPpse, sizeof(selectPpse), resp, respLen)) {
+     *     // resp[respLen - 2], resp[respLen - 1] = SW1 SW2
+     * }
+     * @endcode
+     */
+    bool transceiveAPDU(const uint8_t* cmd, uint16_t cmdLen, uint8_t* resp, uint16_t& respLen);
+
+    /**
+     * @brief Leave ISO-DEP with S(DESELECT) (card goes to HALT)
+     * @return true if the card confirmed
+     */
+    bool isoDepDeselect();
+
+    /**
+     * @brief ISO-DEP session active
+     */
+    bool isoDepActive() const { return _isoActive; }
+
+    /**
+     * @brief Read NTAG / Ultralight pages from the selected tag
+     * @param page First page
+     * @param count Number of pages (4 bytes each)
+     * @param out Output: count * 4 bytes
+     * @return true if every page was read
+     *
+     * Uses FAST_READ for as many pages as fit the receive buffer (31 by
+     * default), READ on tags without FAST_READ. Pages below
+     * CR95HF_NTAG_CACHE_PAGES are cached per UID and served from RAM on
+     * the next call.
+     */
+    bool ntagReadPages(uint8_t page, uint8_t count, uint8_t* out);
+
+    /**
+     * @brief Read the NDEF message of the selected Type 2 tag
+     * @param msg Output: NDEF message (TLV value)
+     * @param msgLen Input: capacity, Output: message length (required length
+     *        if the buffer was too small)
+     * @return true if an NDEF message was read
+     *
+     * Checks the capability container, then walks the TLVs and reads only
+     * up to the end of the NDEF message. The header pages come from the
+     * page cache on repeated reads.
+     */
+    bool ntagReadNdef(uint8_t* msg, uint16_t& msgLen);
+
+    /**
+     * @brief Forget all cached pages (e.g. after writing to a tag)
+     */
+    void ntagClearCache() { memset(_pageCache, 0, sizeof(_pageCache)); }
+
+    /**
+     * @brief Identify the exact model of the selected tag
+     * @param info Output: model, user memory size, raw version
+     * @return false if no tag is selected
+     *
+     * SAK 0x00 tags get GET_VERSION (plus an Ultralight C probe when it is
+     * refused); SAK 0x20 cards are activated with RATS and asked for their
+     * DESFire version. Results are cached per UID (CR95HF_IDENT_CACHE
+     * tags), so the same tag presented again costs no RF exchange.
+     */
+    bool identify(CR95HF_TagInfo& info);
+
+#if CR95HF_FEATURE_NAMES
+    /**
+     * @brief Get model name string
+     * @param model CR95HF_TagModel
+     * @return Name (e.g., "NTAG215")
+     */
+    static const char* getModelName(uint8_t model);
+#endif
+
+#if CR95HF_FEATURE_ISO15693
+    // ========================================================================
+    // ISO15693 (Vicinity)
+    // ========================================================================
+
+    /**
+     * @brief Find the ISO15693 tags in the field
+     * @param tags Output array
+     * @param maxTags Array capacity
+     * @param slots 1: one 1-slot request first, 16-slot rounds only on a
+     *              collision (fastest for a lone tag). 16: start with
+     *              16-slot rounds (fastest for bulk).
+     * @return Number of tags found
+     *
+     * Every collided slot is resolved by another 16-slot round with the
+     * slot number appended to the mask, so one call collects every tag.
+     * Switches the CR95HF to ISO15693; ISO14443-A calls switch it back.
+     */
+    uint8_t iso15693Inventory(CR95HF_VicinityTag* tags, uint8_t maxTags, uint8_t slots = 16);
+
+    /**
+     * @brief Read consecutive blocks with READ MULTIPLE BLOCKS
+     * @param uid Tag UID (as returned by iso15693Inventory())
+     * @param first First block number
+     * @param count Number of blocks
+     * @param out Output: count * blockSize bytes
+     * @param blockSize Block size of the tag (4 for ICODE SLIX, ST25TV)
+     * @return true if every block was read
+     *
+     * Split into as few requests as the RF buffer allows.
+     */
+    bool iso15693ReadBlocks(const uint8_t* uid, uint8_t first, uint8_t count, uint8_t* out,
+                            uint8_t blockSize = 4);
+#endif
+
+    // ========================================================================
+    // ISO14443-B / FeliCa
+    // ========================================================================
+
+#if CR95HF_FEATURE_ISO14443B
+    /**
+     * @brief Poll for an ISO14443-B card (REQB, 1 slot)
+     * @param pupi Output: ISO14443B_PUPI_LEN bytes
+     * @param atqb Optional output: full ATQB (ISO14443B_ATQB_LEN bytes)
+     * @return true if one card answered
+     */
+    bool iso14443bGetPUPI(uint8_t* pupi, uint8_t* atqb = NULL);
+#endif
+
+#if CR95HF_FEATURE_FELICA
+    /**
+     * @brief Poll for a FeliCa card (SENSF_REQ, any system code, 1 slot)
+     * @param idm Output: FELICA_IDM_LEN bytes
+     * @param pmm Optional output: 8 bytes PMm
+     * @return true if one card answered
+     */
+    bool felicaGetIDm(uint8_t* idm, uint8_t* pmm = NULL);
+#endif
+
+    /**
+     * @brief Currently selected RF protocol (CR95HF_PROTO_*)
+     *
+     * Every call switches protocol only when needed; this is the one a
+     * call for the same technology would find selected.
+     */
+    uint8_t protocol() const { return _proto; }
+
+    /**
+     * @brief Switch the RF field off between polls
+     * @param enable true: an ISO14443-A read that finds no tag switches the
+     *               field off; the next wake-up brings it back
+     * @param guardUs Tag power-up time after field-on (ISO14443-3: 5 ms)
+     *
+     * The guard time is waited out before the first RF command after any
+     * field-on; call fieldOn() that long before polling to hide it. The
+     * background task does so by itself.
+     */
+    void setFieldDutyCycle(bool enable, uint16_t guardUs = CR95HF_FIELD_GUARD_US) {
+        _fieldDuty = enable;
+        _guardUs = guardUs;
+    }
+
+    /**
+     * @brief Bring the RF field up ahead of a poll
+     * @param proto Protocol to select (CR95HF_PROTO_*)
+     * @return true if the field is on
+     */
+    bool fieldOn(uint8_t proto = CR95HF_PROTO_ISO14443A);
+
+    /**
+     * @brief Switch the RF field off (tags lose power and selection)
+     * @return true if the CR95HF confirmed
+     */
+    bool fieldOff();
+
+    /**
+     * @brief Total time the RF field has been on (ms)
+     */
+    uint32_t fieldOnMs() const;
+
+#if CR95HF_FEATURE_NAMES
+    /**
+     * @brief Get human-readable card type from SAK byte
+     * @param sak SAK byte value
+     * @return Card type string (e.g., "MIFARE Classic 1K")
+     */
+    const char* getCardType(uint8_t sak);
+#endif
+
+#if CR95HF_FEATURE_DIAGNOSTICS
+    /**
+     * @brief Run self-test and print results to Serial
+     */
+    void selfTest();
+#endif
+
+    /**
+     * @brief Read device identification string
+     * @param out Output buffer for IDN string
+     * @param maxLen Maximum buffer length
+     * @return true if successful
+     */
+    bool readIDN(char* out, uint8_t maxLen);
+
+#if CR95HF_FEATURE_DIAGNOSTICS
+    /**
+     * @brief Measure RF field level
+     * @param level Output: field level (0-100)
+     * @return true if measurement successful
+     */
+    bool measureFieldLevel(uint8_t& level);
+
+    /**
      * @brief Check if antenna/RF field is operational
      * @return true if antenna OK
      */
     bool antennaOK();
+#endif
+
+    /**
+     * @brief Calibrate the tag detector DAC reference
+     * @param dacRef Output: calibrated reference (also stored internally)
+     * @return true if calibration succeeded
+     *
+     * Binary search over the DAC threshold using Idle calibration mode:
+     * below the reference the detector triggers, above it the chip times
+     * out. Run with no tag on the antenna, and again when the antenna
+     * environment changes.
+     */
+    bool calibrateTagDetector(uint8_t& dacRef);
+
+    /**
+     * @brief Set tag detector reference (e.g. restored from flash)
+     * @param dacRef DAC reference from calibrateTagDetector()
+     * @param guard Detection window half-width around dacRef
+     */
+    void setTagDetectorRef(uint8_t dacRef, uint8_t guard = 0x08);
+
+    /**
+     * @brief Sleep in tag-detector mode until a tag approaches
+     * @param timeoutMs Host-side timeout in milliseconds
+     * @param wuPeriod Time between detections (higher = lower current)
+     * @return true if woken by the tag detector
+     *
+     * Puts the CR95HF in Idle with the RF field off, pulsing it briefly every
+     * wake-up period. The calling task blocks on the wake-up byte (use
+     * setRxEvents() so the CPU is idle too). On timeout the chip is woken
+     * through IRQ_IN. ISO14443-A is re-selected before returning, so
+     * iso14443aGetUID() can run right away.
+     *
+     * @note Requires calibrateTagDetector() or setTagDetectorRef() first
+     */
+    bool waitForTag(uint32_t timeoutMs, uint8_t wuPeriod = 0x20);
+
+    /**
+     * @brief Find the best ISO14443-A ARC_B setting with a reference tag
+     * @param arcB Output: best setting (also applied and kept)
+     * @param trials UID reads per setting
+     * @return false if no setting read the tag (previous setting restored)
+     *
+     * Tries every modulation index (10% to 95%) with every receiver gain
+     * (20 to 34 dB) and scores each by successful reads, then by mean read
+     * time. Keep a tag on the antenna while this runs (28 settings x
+     * trials reads, around a second). Store the result and pass it to
+     * setArcB() at boot instead of sweeping again.
+     */
+    bool autoTuneAnalog(uint8_t& arcB, uint8_t trials = 5);
+
+    /**
+     * @brief Use an ISO14443-A ARC_B setting (e.g. restored from flash)
+     * @param arcB Value from autoTuneAnalog(), 0 = chip default
+     * @return true if applied (or stored until ISO14443-A is selected)
+     *
+     * Written again after every ISO14443-A ProtocolSelect, which would
+     * otherwise reload the default.
+     */
+    bool setArcB(uint8_t arcB);
+
+    /**
+     * @brief ARC_B setting in use (0 = chip default)
+     */
+    uint8_t getArcB() const { return _arcB; }
+
+    /**
+     * @brief Read ARC_B back from the CR95HF
+     * @param arcB Output: current register value
+     * @return true if read
+     */
+    bool readArcB(uint8_t& arcB);
+
+    /**
+     * @brief Snapshot of command / response counters and latencies
+     * @note Copied without locking: with the background task running a
+     *       counter may lag by one exchange
+     */
+    CR95HF_Stats getStats() const { return _stats; }
+
+    /**
+     * @brief Clear all counters and histograms
+     */
+    void resetStats() { memset(&_stats, 0, sizeof(_stats)); }
+
+    /**
+     * @brief Learn ISO14443-A reply timeouts from observed latencies
+     * @param enable true: twice the slowest recent reply of each phase
+     *               (CR95HF_PHASE_*), within link time and CR95HF_TMO_MAX_MS
+     *
+     * Off by default: timeouts follow the baud rate and frame length only.
+     * A missed reply restarts its phase from CR95HF_TMO_MAX_MS.
+     */
+    void setAdaptiveTimeouts(bool enable) { _tmoAdaptive = enable; }
+
+    /**
+     * @brief Reply timeout armed for the last command (ms)
+     */
+    uint32_t lastTimeoutMs() const { return _tmoLastMs; }
+
+#if CR95HF_FEATURE_DEBUG
+    /**
+     * @brief Defer debug output to a ring buffer (see begin(debug))
+     * @param enable true: log records go to RAM, printed by flushLog()
+     *
+     * Deferred records cost a header plus a memcpy of the frame bytes on
+     * the hot path instead of a UART print in the middle of an exchange.
+     */
+    void setLogDeferred(bool enable) { _logDeferred = enable; }
+
+    /**
+     * @brief Print and remove deferred log records
+     * @param out Output stream (default Serial)
+     * @param maxRecords Stop after this many records (0 = all)
+     * @return Number of records printed
+     *
+     * Call from loop() or a low-priority task, never from the task that
+     * drives the reader at the same time (single consumer).
+     */
+    uint16_t flushLog(Print& out = Serial, uint16_t maxRecords = 0);
+
+    /**
+     * @brief Start a low-priority task that calls flushLog() periodically
+     * @param periodMs Flush period in milliseconds
+     * @param core CPU core to pin the task to
+     * @param priority FreeRTOS task priority (keep below the reader)
+     * @return true if task started (also enables deferred logging)
+     */
+    bool startLogTask(uint32_t periodMs = 100, BaseType_t core = 0, UBaseType_t priority = 1);
+
+    /**
+     * @brief Stop the log flush task (pending records stay in the ring)
+     */
+    void stopLogTask();
+
+    /**
+     * @brief Log records lost because the ring buffer was full
+     */
+    uint32_t logDropped() const { return _log.dropped(); }
+#endif
+
+    /**
+     * @brief Capture every frame to a binary trace (see CR95HF_Trace.h)
+     * @param trace Trace ring, NULL to stop capturing
+     *
+     * Independent of debug output: records raw TX / RX bytes with micros()
+     * timestamps and the timeout in use. Drain with trace->read() from
+     * another task to stream to SD or network while polling continues.
+     */
+    void setTrace(CR95HF_Trace* trace) { _trace = trace; }
 
     uint8_t lastATQA[2];    ///< Last received ATQA (for debugging)
+#if CR95HF_FEATURE_DIAGNOSTICS
     char deviceName[20];    ///< Device identification string
+#endif
 
 private:
-    HardwareSerial* _port;  ///< Serial port reference
-    int _rxPin;             ///< RX pin number
-    int _txPin;             ///< TX pin number
-    uint32_t _baud;         ///< Baud rate
-    bool _debug;            ///< Debug output enabled
+    /// Built-in UART transport, only constructed by the UART constructor
+    alignas(CR95HF_UartTransport) uint8_t _uartStore[sizeof(CR95HF_UartTransport)];
+    CR95HF_Transport* _link;        ///< Active transport (in _uartStore or external)
+    bool _debug;                    ///< Debug output enabled
 
     CR95HF_Frame _txFrame;  ///< Reusable frame buffer
 
+    CR95HF_Stats _stats;    ///< Command statistics
+    uint32_t _statTxUs;     ///< micros() when the last command was sent
+    uint8_t _statPhase;     ///< Phase of the last command (CR95HF_PHASE_COUNT = none)
+    uint8_t _txLen;         ///< Length of the last command frame
+
+    bool _tmoAdaptive;      ///< Learn ISO14443-A reply timeouts
+    uint32_t _tmoEnvUs[CR95HF_PHASE_COUNT];  ///< Slowest recent reply per phase
+    uint32_t _tmoLastMs;    ///< Timeout of the last exchange
+
+    /// Response parser phases
+    enum RxPhase : uint8_t { RX_CODE, RX_LEN, RX_PAYLOAD, RX_DONE };
+
+    uint8_t _rxPhase;       ///< Current response parser phase
+    uint8_t _rxCode;        ///< Response code being received
+    uint8_t _rxLen;         ///< Announced payload length
+    uint8_t _rxCount;       ///< Payload bytes received so far
+
+    /// Non-blocking UID read steps
+    enum AsyncStep : uint8_t {
+        ASYNC_IDLE, ASYNC_PROTOCOL, ASYNC_ARC, ASYNC_GUARD, ASYNC_WUPA, ASYNC_REQA,
+        ASYNC_ANTICOLL, ASYNC_SELECT, ASYNC_IDN, ASYNC_FIELD_OFF
+    };
+
+    uint8_t _asyncStep;         ///< Current non-blocking read step
+    uint32_t _asyncStart;       ///< millis() when current command was sent
+    uint32_t _asyncTimeout;     ///< Timeout of current command (ms)
+    uint8_t _asyncLevel;        ///< Cascade level being resolved (0-2)
+    const uint8_t* _asyncCL;    ///< Cascade level UID bytes + BCC (in _rfBuf)
+    CR95HF_UIDResult _asyncResult;  ///< Result being assembled
+    CR95HF_AsyncStatus _asyncEnd;   ///< Status reported once IDN / PROTO_OFF is answered
+
+    uint8_t _tdRef;                 ///< Tag detector DAC reference
+    uint8_t _tdGuard;               ///< Tag detector window half-width
+    bool _tdValid;                  ///< Tag detector reference set
+    uint8_t _arcB;                  ///< ISO14443-A ARC_B override (0 = default)
+
+    bool _tagHalted;                ///< Last tag talked to was sent HLTA
+    uint8_t _wakeRsp;               ///< Response code of the last WUPA / REQA (0 = none)
+    bool _atqaPending;              ///< Tag READY, lastATQA valid (cleared by the next command)
+    CR95HF_WakeStrategy _wakeStrategy;  ///< Wake-up command of the UID reads
+    bool _wakeToggle;               ///< CR95HF_WAKE_ALTERNATE: REQA next
+    bool _fieldDuty;                ///< Field off after an empty poll
+    bool _fieldFresh;               ///< Field came on, guard time not yet waited
+    uint16_t _guardUs;              ///< Tag power-up time after field-on
+    uint32_t _fieldOnUs;            ///< micros() at the last field-on
+    uint64_t _fieldOnAccUs;         ///< Field-on time before the last field-on
+    bool _idnPending;               ///< beginFast(): IDN not verified yet
+    uint8_t _proto;                 ///< Selected protocol (CR95HF_PROTO_*)
+
+    uint8_t _rfBuf[CR95HF_RF_BUFFER];   ///< Shared receive buffer, RF exchange frame
+    bool _isoActive;                ///< ISO-DEP session open
+    bool _isoConfigured;            ///< ProtocolSelect differs from default
+    uint8_t _isoBlockNum;           ///< Current ISO-DEP block number (0/1)
+    uint8_t _isoRates;              ///< ProtocolSelect bit rate parameter
+    uint8_t _isoFwi;                ///< Card frame waiting time integer
+    uint16_t _isoFsc;               ///< Card frame size
+
+    uint8_t _selUid[10];            ///< UID of the ACTIVE tag
+    uint8_t _selUidLen;             ///< Its length (0 = none selected)
+    uint8_t _selSak;                ///< Its SAK
+
+    /// identify() result cache entry
+    struct IdentEntry {
+        uint8_t uid[10];
+        uint8_t uidLen;
+        uint32_t used;
+        CR95HF_TagInfo info;
+    };
+    IdentEntry _ident[CR95HF_IDENT_CACHE];  ///< identify() cache
+    CR95HF_PageCache _pageCache[CR95HF_NTAG_CACHE_TAGS];    ///< NTAG page caches
+
+    CR95HF_TrackedTag _tracked[CR95HF_TRACK_CAPACITY];  ///< Tag tracking cache
+    uint32_t _trackHoldOff;         ///< Leave hold-off (ms)
+    uint8_t _trackMisses;           ///< Leave miss tolerance
+    CR95HF_TagCallback _onEnter;    ///< Tag enter callback
+    CR95HF_TagCallback _onLeave;    ///< Tag leave callback
+
+    TaskHandle_t volatile _task;    ///< Background reader task (cleared by the task on exit)
+    volatile bool _taskRun;         ///< Cleared to request task exit
+    SemaphoreHandle_t _taskDone;    ///< Given by the task as it exits
+    StaticSemaphore_t _taskDoneBuf; ///< Static storage for _taskDone
+    uint32_t _taskPeriod;           ///< Background poll period (ms)
+    volatile uint32_t _eventsDropped;   ///< Events lost to a full queue
+
+    CR95HF_ScanCallback _scanCb;    ///< Continuous scan callback (empty = event queue mode)
+    CR95HF_ScanConfig _scanCfg;     ///< Continuous scan settings
+    CR95HF_TagEvent _scanBatch[CR95HF_SCAN_BATCH_MAX];  ///< Records not yet delivered
+    uint8_t _scanCount;             ///< Records in _scanBatch
+    uint32_t _scanFirstMs;          ///< millis() of the first record held
+    volatile uint32_t _scanBatches; ///< Batches delivered
+    volatile uint32_t _scanRetries; ///< Re-reads after failed reads
+    CR95HF_EventQueue<CR95HF_TagEvent, CR95HF_EVENT_QUEUE_SIZE> _events;
+
+    CR95HF_Trace* _trace;           ///< Frame trace (NULL = off)
+
+#if CR95HF_FEATURE_DEBUG
+    CR95HF_LogRing _log;            ///< Deferred debug records
+    bool _logDeferred;              ///< Debug output goes to _log
+    TaskHandle_t volatile _logTask; ///< Log flush task (cleared by the task on exit)
+    volatile bool _logTaskRun;      ///< Cleared to request log task exit
+    SemaphoreHandle_t _logTaskDone; ///< Given by the log task as it exits
+    StaticSemaphore_t _logTaskDoneBuf;  ///< Static storage for _logTaskDone
+    uint32_t _logPeriod;            ///< Log flush period (ms)
+
     // Debug helpers
     void log(const char* msg);
-    void logHex(const char* prefix, const uint8_t* data, uint8_t len);
+    void logValue(const char* fmt, uint32_t value);
+    void logFrame(uint8_t type, uint8_t code, const uint8_t* data, uint8_t len);
+    static void printHex(Print& out, const char* prefix, const uint8_t* data, uint8_t len);
+    static void printRecord(Print& out, uint8_t type, const uint8_t* p, uint8_t len);
+    static void logTaskEntry(void* arg);
+#else
+    // Debug helpers compiled out, so are their format strings
+    void log(const char*) {}
+    void logValue(const char*, uint32_t) {}
+    void logFrame(uint8_t, uint8_t, const uint8_t*, uint8_t) {}
+#endif
+    void traceRx(bool ok, const uint8_t* buf, uint8_t len, uint32_t timeoutMs);
 
     // Low-level communication
     void flushRx();
-    void sendFrame(const CR95HF_Frame& frame);
-    bool readResponse(uint8_t& code, uint8_t* buf, uint8_t& len, uint32_t timeoutMs);
+    void sendFrame(CR95HF_Bytes frame);
+    bool readResponse(uint8_t& code, uint8_t* buf, uint8_t& len, uint32_t timeoutMs = 0);
+    uint32_t replyTimeout(uint16_t rxBytes) const;
+    void waitRx(uint32_t start, uint32_t timeoutMs);
+    void rxReset();
+    bool rxProcess(uint8_t* buf, uint8_t size);
+    void statCommand(CR95HF_Bytes frame);
+    void statResponse(uint8_t code);
+    void statTimeout();
+
+    // Non-blocking UID read
+    void asyncIssue(uint8_t step);
+    void asyncWake();
+    CR95HF_AsyncStatus asyncFinish(CR95HF_AsyncStatus status);
+
+    // Background reader task
+    static void taskEntry(void* arg);
+    void taskLoop();
+    void scanAdd(const CR95HF_TagEvent& ev);
+    void scanDeliver();
 
     // Protocol operations
-    bool echoTest();
-    bool protocolSelectA();
+    bool echoTest(uint32_t timeoutMs = 50);
+    void warmCheck();
+    void warmCompare(const char* name);
+    bool selectProtocol(uint8_t proto, bool force = false);
+    void protocolSelected(uint8_t proto);
+#if CR95HF_FEATURE_STATUS1
+    bool rfRequest(const uint8_t* req, uint8_t reqLen, uint8_t rxRf, uint8_t& rxLen,
+                   bool& collision);
+#endif
+#if CR95HF_FEATURE_ISO15693
+    void iso15693Round(const uint8_t* mask, uint8_t maskBits, CR95HF_VicinityTag* tags,
+                       uint8_t maxTags, uint8_t& found);
+#endif
+    bool fieldReset();
+    void fieldWentOff();
+    void fieldGuard();
+    uint8_t idleCalibProbe(uint8_t dacH);
+    bool writeArcB(uint8_t value);
     bool sendReqWup(uint8_t cmd, uint8_t& atqa1, uint8_t& atqa2);
-    bool anticollCL1(uint8_t* cl1);
-    bool selectCL1(const uint8_t* cl1, uint8_t& sak);
-    bool anticollCL2(uint8_t* cl2);
-    bool selectCL2(const uint8_t* cl2, uint8_t& sak);
+    uint8_t wakeCommand();
+    bool readView(CR95HF_ResponseView& view, uint8_t maxLen = CR95HF_RX_ISO3_MAX);
+    CR95HF_ResponseView viewOf(uint8_t code, uint8_t len) const;
+    bool tagAnswer(const CR95HF_ResponseView& view, uint8_t minLen);
+    bool bccOk(const uint8_t* cl);
+    bool cascadeLevel(uint8_t level, uint8_t* uid, uint8_t& n, uint8_t& sak);
+    bool selectLevel(uint8_t sel, const uint8_t* cl, uint8_t& sak);
+    bool anticollResolve(uint8_t sel, uint8_t* cl);
+    bool selectResolved(CR95HF_UIDResult& tag);
+    uint8_t collectTags(uint8_t wakeCmd, CR95HF_UIDResult* tags, uint8_t maxTags);
+    CR95HF_TrackedTag* findTracked(const CR95HF_UIDResult& tag);
+
+    // RF exchange / ISO-DEP
+    bool rfExchange(const uint8_t* hdr, uint8_t hdrLen, const uint8_t* body, uint8_t bodyLen,
+                    uint32_t timeoutMs, uint8_t& rxLen);
+    bool isoDepConfigure(uint8_t rates, uint8_t fwi, uint8_t fwtMult);
+    uint32_t isoDepTimeout(uint8_t wtxm, uint16_t txRf) const;
+    void isoDepReset();
+    uint32_t linkMs(uint16_t bytes) const;
+    uint32_t rfTimeout(uint16_t txRf, uint16_t rxRf, uint16_t byteUs, uint16_t frameUs) const;
+    uint32_t idleTimeout(uint32_t sleepCycles) const;
+    bool drainRx(uint32_t maxMs);
+
+    // Selected tag / NTAG memory
+    bool selectKnown(const uint8_t* uid, uint8_t uidLen);
+    void setSelected(const uint8_t* uid, uint8_t uidLen, uint8_t sak);
+    void identifyType2(CR95HF_TagInfo& info);
+    void identifyIsoDep(CR95HF_TagInfo& info);
+    CR95HF_PageCache* pageCacheEntry();
+    bool ntagFetch(CR95HF_PageCache& c, uint8_t page, uint8_t count,
+                   uint16_t offset, uint8_t* out, uint16_t n);
+    bool ntagReadBytes(uint16_t offset, uint8_t* out, uint16_t n);
 };
@@ -0,0 +1,110 @@
+/**
+ * @file    CR95HFGroup.cpp
+ * @brief   Interleaved polling of several CR95HF readers
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#include "CR95HFGroup.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+CR95HFGroup::CR95HFGroup()
+    : _count(0), _pending(0), _sweepStart(0), _sweepUs(0)
+{
+}
+
+/**
+ * @brief Add a reader
+ * @param reader Initialised reader
+ * @return Reader index, or -1 if full
+ */
+int CR95HFGroup::add(CR95HF& reader) {
+    if (_count >= CR95HF_GROUP_MAX || busy()) return -1;
+    _readers[_count] = &reader;
+    return _count++;
+}
+
+// ============================================================================
+// Sweep
+// ============================================================================
+
+/**
+ * @brief Start a UID read on every reader
+ * @return false if a sweep is already running
+ */
+bool CR95HFGroup::start() {
+    if (busy()) return false;
+
+    _sweepStart = micros();
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_readers[i]->startGetUID()) _pending |= (1 << i);
+    }
+    return true;
+}
+
+/**
+ * @brief Advance all readers without waiting
+ * @param results Output: one entry per reader
+ * @return true when the sweep is complete
+ */
+bool CR95HFGroup::poll(CR95HF_GroupResult* results) {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (!(_pending & (1 << i))) continue;
+
+        CR95HF_AsyncStatus st = _readers[i]->poll(results[i].uid);
+        if (st == CR95HF_ASYNC_BUSY) continue;
+
+        results[i].status = st;
+        _pending &= ~(1 << i);
+    }
+
+    if (_pending) return false;
+    _sweepUs = micros() - _sweepStart;
+    return true;
+}
+
+/**
+ * @brief Run one complete sweep
+ * @param results Output: one entry per reader
+ * @param timeoutMs Abort readers still busy after this long
+ * @return Number of readers that read a UID
+ */
+uint8_t CR95HFGroup::readAll(CR95HF_GroupResult* results, uint32_t timeoutMs) {
+    for (uint8_t i = 0; i < _count; i++) {
+        results[i].status = CR95HF_ASYNC_IDLE;
+    }
+    if (!start()) return 0;
+
+    // Each reader's state machine times out its own exchanges; the overall
+    // limit only catches a reader that keeps streaming garbage
+    uint32_t t0 = millis();
+    while (!poll(results)) {
+        if (millis() - t0 > timeoutMs) {
+            cancel();
+            break;
+        }
+        yield();
+    }
+
+    uint8_t found = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        if (results[i].status == CR95HF_ASYNC_DONE) found++;
+    }
+    return found;
+}
+
+/**
+ * @brief Abort the sweep in progress
+ */
+void CR95HFGroup::cancel() {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_pending & (1 << i)) _readers[i]->cancel();
+    }
+    _pending = 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file    CR95HFGroup.h
+ * @brief   Interleaved polling of several CR95HF readers
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * A blocking iso14443aGetUID() on each reader in turn costs the sum of
+ * all reader latencies. CR95HFGroup drives the non-blocking startGetUID()
+ * / poll() state machines of every reader side by side: each command goes
+ * out on all ports before any response is awaited, so a sweep costs about
+ * as much as the slowest reader.
+ *
+ * @code
+ * CR95HF nfc1(Serial1, 1, 2), nfc2(Serial2, 4, 5);
+ * CR95HFGroup readers;
+ * readers.add(nfc1);
+ * readers.add(nfc2);
+ *
+ * CR95HF_GroupResult res[CR95HF_GROUP_MAX];
+ * if (readers.readAll(res)) {
+ *     // res[i].status == CR95HF_ASYNC_DONE: res[i].uid valid for reader i
+ * }
+ * @endcode
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#pragma once
+
+#include "CR95HF.h"
+
+/// Readers per group
+#ifndef CR95HF_GROUP_MAX
+#define CR95HF_GROUP_MAX        4
+#endif
+
+/**
+ * @brief Outcome of one reader in a sweep
+ */
+struct CR95HF_GroupResult {
+    CR95HF_AsyncStatus status;  ///< CR95HF_ASYNC_DONE / NO_TAG / ERROR (IDLE = not run)
+    CR95HF_UIDResult uid;       ///< Valid when status == CR95HF_ASYNC_DONE
+};
+
+// ============================================================================
+// CR95HFGroup - Multi-Reader Scheduler
+// ============================================================================
+
+/**
+ * @class   CR95HFGroup
+ * @brief   Runs the non-blocking UID read on several readers at once
+ *
+ * Readers must be initialised with begin() and must not run their own
+ * background task. All calls come from one task.
+ */
+class CR95HFGroup {
+public:
+    CR95HFGroup();
+
+    /**
+     * @brief Add a reader
+     * @param reader Initialised reader (must outlive the group)
+     * @return Reader index, or -1 if the group is full
+     */
+    int add(CR95HF& reader);
+
+    /**
+     * @brief Number of readers
+     */
+    uint8_t size() const { return _count; }
+
+    /**
+     * @brief Reader by index
+     */
+    CR95HF& reader(uint8_t index) const { return *_readers[index]; }
+
+    /**
+     * @brief Start a UID read on every reader
+     * @return false if a sweep is already running
+     */
+    bool start();
+
+    /**
+     * @brief Advance all readers without waiting
+     * @param results Output: one entry per reader, filled as readers finish
+     * @return true when every reader has finished (sweep complete)
+     */
+    bool poll(CR95HF_GroupResult* results);
+
+    /**
+     * @brief Run one complete sweep
+     * @param results Output: one entry per reader (size() entries)
+     * @param timeoutMs Abort readers still busy after this long
+     * @return Number of readers that read a UID
+     */
+    uint8_t readAll(CR95HF_GroupResult* results, uint32_t timeoutMs = 250);
+
+    /**
+     * @brief Abort the sweep in progress
+     */
+    void cancel();
+
+    /**
+     * @brief Sweep in progress
+     */
+    bool busy() const { return _pending != 0; }
+
+    /**
+     * @brief Duration of the last completed sweep (microseconds)
+     */
+    uint32_t lastSweepUs() const { return _sweepUs; }
+
+private:
+    CR95HF* _readers[CR95HF_GROUP_MAX]; ///< Readers in the group
+    uint8_t _count;                 ///< Readers added
+    uint8_t _pending;               ///< Bit mask of readers still busy
+    uint32_t _sweepStart;           ///< micros() at start()
+    uint32_t _sweepUs;              ///< Last sweep duration
+};
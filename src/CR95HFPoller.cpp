@@ -0,0 +1,198 @@
+/**
+ * @file    CR95HFPoller.cpp
+ * @brief   Multi-protocol polling scheduler implementation
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#include "CR95HFPoller.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+CR95HFPoller::CR95HFPoller(CR95HF& reader)
+    : _reader(reader), _count(0), _maxWeight(CR95HF_POLL_MAX_WEIGHT), _cur(0), _left(0),
+      _started(false), _runHit(false), _switches(0), _totalUs(0)
+{
+    memset(_stats, 0, sizeof(_stats));
+}
+
+/**
+ * @brief Add a technology to the cycle
+ * @param proto CR95HF_PROTO_*
+ * @return false if unsupported, already added or full
+ */
+bool CR95HFPoller::addProtocol(uint8_t proto) {
+    switch (proto) {
+        case CR95HF_PROTO_ISO14443A: break;
+#if CR95HF_FEATURE_ISO14443B
+        case CR95HF_PROTO_ISO14443B: break;
+#endif
+#if CR95HF_FEATURE_FELICA
+        case CR95HF_PROTO_FELICA:    break;
+#endif
+#if CR95HF_FEATURE_ISO15693
+        case CR95HF_PROTO_ISO15693:  break;
+#endif
+        default: return false;
+    }
+    if (_count >= CR95HF_POLL_MAX_PROTOCOLS || indexOf(proto) >= 0) return false;
+
+    _protos[_count] = proto;
+    _weight[_count] = 1;
+    _count++;
+    return true;
+}
+
+/**
+ * @brief Index of a configured technology
+ * @return Index, or -1
+ */
+int CR95HFPoller::indexOf(uint8_t proto) const {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_protos[i] == proto) return i;
+    }
+    return -1;
+}
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+/**
+ * @brief End the current run and start the next technology's
+ *
+ * A run that found nothing loses one slot; the first run starts with the
+ * protocol already selected, so it costs no switch.
+ */
+void CR95HFPoller::nextRun() {
+    if (!_started) {
+        int here = indexOf(_reader.protocol());
+        _cur = (here >= 0) ? here : 0;
+        _started = true;
+    } else {
+        if (!_runHit && _weight[_cur] > 1) _weight[_cur]--;
+        _cur = (_cur + 1) % _count;
+    }
+    _left = _weight[_cur];
+    _runHit = false;
+}
+
+/**
+ * @brief Run one detection slot
+ * @param result Output: tag found
+ * @return true if a tag was found
+ */
+bool CR95HFPoller::poll(CR95HF_PollResult& result) {
+    if (_count == 0) return false;
+    if (_left == 0) nextRun();
+
+    uint8_t proto = _protos[_cur];
+    if (_reader.protocol() != proto) _switches++;
+
+    uint32_t t0 = micros();
+    bool found = detect(proto, result);
+    uint32_t us = micros() - t0;
+
+    CR95HF_PollStats& s = _stats[_cur];
+    s.slots++;
+    s.busyUs += us;
+    _totalUs += us;
+    _left--;
+
+    if (found) {
+        s.found++;
+        _runHit = true;
+        _weight[_cur] = _maxWeight;
+    }
+    return found;
+}
+
+/**
+ * @brief One detection attempt with a technology
+ * @param proto CR95HF_PROTO_*
+ * @param result Output
+ * @return true if a tag answered
+ */
+bool CR95HFPoller::detect(uint8_t proto, CR95HF_PollResult& result) {
+    memset(&result, 0, sizeof(result));
+    result.proto = proto;
+
+    switch (proto) {
+        case CR95HF_PROTO_ISO14443A:
+            return _reader.iso14443aGetUID(result.id, result.idLen, result.sak);
+
+#if CR95HF_FEATURE_ISO14443B
+        case CR95HF_PROTO_ISO14443B:
+            result.idLen = ISO14443B_PUPI_LEN;
+            return _reader.iso14443bGetPUPI(result.id);
+#endif
+
+#if CR95HF_FEATURE_FELICA
+        case CR95HF_PROTO_FELICA:
+            result.idLen = FELICA_IDM_LEN;
+            return _reader.felicaGetIDm(result.id);
+#endif
+
+#if CR95HF_FEATURE_ISO15693
+        case CR95HF_PROTO_ISO15693: {
+            CR95HF_VicinityTag tag;
+            if (_reader.iso15693Inventory(&tag, 1, 1) == 0) return false;
+            memcpy(result.id, tag.uid, ISO15693_UID_LEN);
+            result.idLen = ISO15693_UID_LEN;
+            return true;
+        }
+#endif
+
+        default:
+            return false;
+    }
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+/**
+ * @brief Share of polling time spent on a technology
+ * @param proto CR95HF_PROTO_*
+ * @return Percent
+ */
+uint8_t CR95HFPoller::dutyCycle(uint8_t proto) const {
+    int i = indexOf(proto);
+    if (i < 0 || _totalUs == 0) return 0;
+    return (uint8_t)(_stats[i].busyUs * 100 / _totalUs);
+}
+
+/**
+ * @brief Counters of a technology
+ * @param proto CR95HF_PROTO_*
+ * @return Counters, or NULL
+ */
+const CR95HF_PollStats* CR95HFPoller::stats(uint8_t proto) const {
+    int i = indexOf(proto);
+    return (i < 0) ? NULL : &_stats[i];
+}
+
+/**
+ * @brief Current weight of a technology
+ * @param proto CR95HF_PROTO_*
+ * @return Slots per run, 0 if not configured
+ */
+uint8_t CR95HFPoller::weight(uint8_t proto) const {
+    int i = indexOf(proto);
+    return (i < 0) ? 0 : _weight[i];
+}
+
+/**
+ * @brief Clear counters
+ */
+void CR95HFPoller::resetStats() {
+    memset(_stats, 0, sizeof(_stats));
+    _switches = 0;
+    _totalUs = 0;
+}
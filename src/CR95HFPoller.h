@@ -0,0 +1,149 @@
+/**
+ * @file    CR95HFPoller.h
+ * @brief   Multi-protocol polling scheduler for one CR95HF
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * Cycles through a set of RF technologies (ISO14443-A, ISO14443-B, FeliCa,
+ * ISO15693), one detection attempt per poll() call. Every switch costs a
+ * ProtocolSelect round trip plus field settling, so the slots of one
+ * technology run back to back: a cycle makes exactly one switch per
+ * configured protocol. Technologies that found a tag get more consecutive
+ * slots (up to the maximum weight); their weight decays by one per run
+ * without a tag, never below one slot.
+ *
+ * @code
+ * CR95HFPoller poller(nfc);
+ * poller.addProtocol(CR95HF_PROTO_ISO14443A);
+ * poller.addProtocol(CR95HF_PROTO_ISO15693);
+ *
+ * CR95HF_PollResult tag;
+ * if (poller.poll(tag)) {
+ *     // tag.proto, tag.id[0..tag.idLen-1]
+ * }
+ * Serial.printf("15693: %u%%\n", poller.dutyCycle(CR95HF_PROTO_ISO15693));
+ * @endcode
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#pragma once
+
+#include "CR95HF.h"
+
+/// Protocols per poller (A plus the B, FeliCa, 15693 support built in)
+#define CR95HF_POLL_MAX_PROTOCOLS \
+    (1 + CR95HF_FEATURE_ISO14443B + CR95HF_FEATURE_FELICA + CR95HF_FEATURE_ISO15693)
+
+/// Default maximum consecutive slots for a technology that found a tag
+#ifndef CR95HF_POLL_MAX_WEIGHT
+#define CR95HF_POLL_MAX_WEIGHT  4
+#endif
+
+/**
+ * @brief Tag found by one poll slot
+ */
+struct CR95HF_PollResult {
+    uint8_t proto;          ///< CR95HF_PROTO_*
+    uint8_t id[10];         ///< UID / PUPI / IDm / ISO15693 UID (LSB first)
+    uint8_t idLen;          ///< 4, 7, 8 or 10
+    uint8_t sak;            ///< SAK (ISO14443-A only)
+};
+
+/**
+ * @brief Per-protocol counters
+ */
+struct CR95HF_PollStats {
+    uint32_t slots;         ///< Detection attempts
+    uint32_t found;         ///< Attempts that found a tag
+    uint64_t busyUs;        ///< Time spent, including protocol switches
+};
+
+// ============================================================================
+// CR95HFPoller - Multi-Protocol Scheduler
+// ============================================================================
+
+/**
+ * @class   CR95HFPoller
+ * @brief   Weighted, switch-minimising polling over several RF technologies
+ *
+ * The reader must be initialised with begin(). All calls come from one
+ * task; other driver calls in between are fine (the poller only relies on
+ * the driver skipping redundant ProtocolSelects).
+ */
+class CR95HFPoller {
+public:
+    /**
+     * @brief Constructor
+     * @param reader Initialised reader (must outlive the poller)
+     */
+    explicit CR95HFPoller(CR95HF& reader);
+
+    /**
+     * @brief Add a technology to the cycle
+     * @param proto CR95HF_PROTO_ISO14443A / ISO14443B / FELICA / ISO15693
+     * @return false if unsupported (or compiled out), already added or full
+     */
+    bool addProtocol(uint8_t proto);
+
+    /**
+     * @brief Maximum consecutive slots a technology can earn
+     * @param weight 1 = plain round robin
+     */
+    void setMaxWeight(uint8_t weight) { _maxWeight = weight ? weight : 1; }
+
+    /**
+     * @brief Run one detection slot
+     * @param result Output: tag found (valid when returning true)
+     * @return true if a tag was found
+     */
+    bool poll(CR95HF_PollResult& result);
+
+    /**
+     * @brief Share of polling time spent on a technology
+     * @param proto CR95HF_PROTO_*
+     * @return Percent (0-100), 0 if not configured
+     */
+    uint8_t dutyCycle(uint8_t proto) const;
+
+    /**
+     * @brief Counters of a technology
+     * @param proto CR95HF_PROTO_*
+     * @return Counters, NULL if not configured
+     */
+    const CR95HF_PollStats* stats(uint8_t proto) const;
+
+    /**
+     * @brief Current weight (consecutive slots per run) of a technology
+     */
+    uint8_t weight(uint8_t proto) const;
+
+    /**
+     * @brief Protocol switches made so far
+     */
+    uint32_t switches() const { return _switches; }
+
+    /**
+     * @brief Clear counters (weights are kept)
+     */
+    void resetStats();
+
+private:
+    CR95HF& _reader;                ///< Reader polled
+    uint8_t _protos[CR95HF_POLL_MAX_PROTOCOLS];     ///< Configured technologies
+    uint8_t _weight[CR95HF_POLL_MAX_PROTOCOLS];     ///< Slots per run
+    CR95HF_PollStats _stats[CR95HF_POLL_MAX_PROTOCOLS];  ///< Counters
+    uint8_t _count;                 ///< Technologies configured
+    uint8_t _maxWeight;             ///< Weight after a hit
+    uint8_t _cur;                   ///< Technology of the current run
+    uint8_t _left;                  ///< Slots left in the current run
+    bool _started;                  ///< First run chosen
+    bool _runHit;                   ///< Current run found a tag
+    uint32_t _switches;             ///< Protocol changes
+    uint64_t _totalUs;              ///< Time in all slots (32 bits wrap after 71 min)
+
+    int indexOf(uint8_t proto) const;
+    void nextRun();
+    bool detect(uint8_t proto, CR95HF_PollResult& result);
+};
@@ -0,0 +1,156 @@
+/**
+ * @file    CR95HF_Bench.cpp
+ * @brief   Timing helpers for on-target CR95HF benchmarks
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#include "CR95HF_Bench.h"
+
+// ============================================================================
+// CR95HF_LatencySampler
+// ============================================================================
+
+/**
+ * @brief Drop all samples
+ */
+void CR95HF_LatencySampler::clear() {
+    _kept = 0;
+    _sorted = true;
+    _seen = 0;
+    _sum = 0;
+    _min = 0xFFFFFFFF;
+    _max = 0;
+    _rng = 0x2545F491;
+}
+
+/**
+ * @brief Add one sample
+ * @param us Latency in microseconds
+ */
+void CR95HF_LatencySampler::add(uint32_t us) {
+    _seen++;
+    _sum += us;
+    if (us < _min) _min = us;
+    if (us > _max) _max = us;
+
+    if (_kept < CR95HF_BENCH_SAMPLES) {
+        _samples[_kept++] = us;
+        _sorted = false;
+        return;
+    }
+
+    // Reservoir: keep the new sample with probability N / seen
+    _rng ^= _rng << 13;
+    _rng ^= _rng >> 17;
+    _rng ^= _rng << 5;
+    uint32_t slot = _rng % _seen;
+    if (slot < CR95HF_BENCH_SAMPLES) {
+        _samples[slot] = us;
+        _sorted = false;
+    }
+}
+
+/**
+ * @brief Nearest-rank percentile of the kept samples
+ * @param pct Percentile (1-100)
+ * @return Latency in microseconds (0 if no samples)
+ */
+uint32_t CR95HF_LatencySampler::percentile(uint8_t pct) {
+    if (_kept == 0) return 0;
+    if (pct > 100) pct = 100;
+
+    if (!_sorted) {
+        // Insertion sort: N is small and the data is often nearly sorted
+        for (uint16_t i = 1; i < _kept; i++) {
+            uint32_t v = _samples[i];
+            uint16_t j = i;
+            while (j > 0 && _samples[j - 1] > v) {
+                _samples[j] = _samples[j - 1];
+                j--;
+            }
+            _samples[j] = v;
+        }
+        _sorted = true;
+    }
+
+    uint32_t rank = ((uint32_t)pct * _kept + 99) / 100;
+    return _samples[rank ? rank - 1 : 0];
+}
+
+// ============================================================================
+// CR95HF_CpuLoad
+// ============================================================================
+
+/**
+ * @brief Counting task body, runs whenever the core has nothing else to do
+ * @param arg CR95HF_CpuLoad instance
+ */
+void CR95HF_CpuLoad::countTask(void* arg) {
+    CR95HF_CpuLoad* self = static_cast<CR95HF_CpuLoad*>(arg);
+    for (;;) {
+        self->_count = self->_count + 1;
+    }
+}
+
+/**
+ * @brief Start the counting task
+ * @param core Core to measure (-1 = core of the caller)
+ * @return true if task created
+ */
+bool CR95HF_CpuLoad::begin(int core) {
+    if (_task != NULL) return true;
+    if (core < 0) core = xPortGetCoreID();
+
+    // Idle priority: shares time with the IDLE task, never delays real work
+    if (xTaskCreatePinnedToCore(countTask, "cpuload", 1024, this,
+                                tskIDLE_PRIORITY, &_task, core) != pdPASS) {
+        _task = NULL;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Stop the counting task
+ */
+void CR95HF_CpuLoad::end() {
+    if (_task == NULL) return;
+    vTaskDelete(_task);
+    _task = NULL;
+}
+
+/**
+ * @brief Measure the idle count rate
+ * @param ms Calibration time
+ */
+void CR95HF_CpuLoad::calibrate(uint32_t ms) {
+    if (ms == 0) ms = 1;
+    uint32_t c0 = _count;
+    delay(ms);
+    _rate = (float)(_count - c0) / ms;
+}
+
+/**
+ * @brief Start a measurement window
+ */
+void CR95HF_CpuLoad::start() {
+    _startCount = _count;
+    _startMs = millis();
+}
+
+/**
+ * @brief End the measurement window
+ * @return Busy fraction 0.0 .. 1.0
+ */
+float CR95HF_CpuLoad::stop() {
+    uint32_t ms = millis() - _startMs;
+    if (ms == 0 || _rate <= 0) return 0;
+
+    float idle = (float)(_count - _startCount) / ms / _rate;
+    if (idle > 1) idle = 1;
+    return 1 - idle;
+}
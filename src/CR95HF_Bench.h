@@ -0,0 +1,158 @@
+/**
+ * @file    CR95HF_Bench.h
+ * @brief   Timing helpers for on-target CR95HF benchmarks
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * Two small tools used by examples/Benchmark, usable on their own:
+ * - CR95HF_LatencySampler: fixed-size latency sample store with
+ *   min / max / mean and exact percentiles (p50, p99, ...)
+ * - CR95HF_CpuLoad: busy fraction of one CPU core, measured with a
+ *   lowest-priority counting task calibrated against an idle core
+ *
+ * @code
+ * #include <CR95HF_Bench.h>
+ *
+ * CR95HF_LatencySampler lat;
+ * uint32_t t0 = micros();
+ * nfc.iso14443aGetUID(uid, uidLen, sak);
+ * lat.add(micros() - t0);
+ * Serial.printf("p99 = %lu us\n", lat.percentile(99));
+ * @endcode
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+/// Samples kept per CR95HF_LatencySampler (reservoir sampled beyond that)
+#ifndef CR95HF_BENCH_SAMPLES
+#define CR95HF_BENCH_SAMPLES 128
+#endif
+
+// ============================================================================
+// CR95HF_LatencySampler - Latency Percentiles
+// ============================================================================
+
+/**
+ * @class   CR95HF_LatencySampler
+ * @brief   Latency samples with exact percentiles
+ *
+ * Keeps up to CR95HF_BENCH_SAMPLES values. Once full, new values replace
+ * random old ones (reservoir sampling) so percentiles stay representative
+ * of the whole run. Min, max and mean always cover every sample.
+ */
+class CR95HF_LatencySampler {
+public:
+    CR95HF_LatencySampler() { clear(); }
+
+    /**
+     * @brief Drop all samples
+     */
+    void clear();
+
+    /**
+     * @brief Add one sample
+     * @param us Latency in microseconds
+     */
+    void add(uint32_t us);
+
+    /**
+     * @brief Number of samples added since clear()
+     */
+    uint32_t count() const { return _seen; }
+
+    uint32_t minUs() const { return _seen ? _min : 0; }    ///< Smallest sample
+    uint32_t maxUs() const { return _max; }                ///< Largest sample
+    uint32_t meanUs() const { return _seen ? (uint32_t)(_sum / _seen) : 0; }  ///< Average
+
+    /**
+     * @brief Nearest-rank percentile of the kept samples
+     * @param pct Percentile (1-100)
+     * @return Latency in microseconds (0 if no samples)
+     */
+    uint32_t percentile(uint8_t pct);
+
+private:
+    uint32_t _samples[CR95HF_BENCH_SAMPLES];    ///< Kept samples
+    uint16_t _kept;                 ///< Valid entries in _samples
+    bool _sorted;                   ///< _samples sorted ascending
+    uint32_t _seen;                 ///< Samples added
+    uint64_t _sum;                  ///< Sum of all samples
+    uint32_t _min;                  ///< Smallest sample
+    uint32_t _max;                  ///< Largest sample
+    uint32_t _rng;                  ///< Reservoir sampling PRNG state
+};
+
+// ============================================================================
+// CR95HF_CpuLoad - Core Busy Fraction
+// ============================================================================
+
+/**
+ * @class   CR95HF_CpuLoad
+ * @brief   Measure how busy one core is while the driver runs
+ *
+ * A counting task runs at idle priority on the measured core and only
+ * gets CPU time nobody else wants. calibrate() records its count rate on
+ * an idle core; during a measurement a lower rate means the core was busy.
+ * Blocking waits (event-driven receive, FreeRTOS delays) count as idle.
+ *
+ * @code
+ * CR95HF_CpuLoad cpu;
+ * cpu.begin();
+ * cpu.calibrate(500);
+ * cpu.start();
+ * ... polling ...
+ * Serial.printf("busy %.1f %%\n", cpu.stop() * 100);
+ * @endcode
+ */
+class CR95HF_CpuLoad {
+public:
+    CR95HF_CpuLoad() : _task(NULL), _count(0), _rate(0), _startCount(0), _startMs(0) {}
+    ~CR95HF_CpuLoad() { end(); }
+
+    /**
+     * @brief Start the counting task
+     * @param core Core to measure (-1 = core of the caller)
+     * @return true if task created
+     */
+    bool begin(int core = -1);
+
+    /**
+     * @brief Stop the counting task
+     */
+    void end();
+
+    /**
+     * @brief Measure the idle count rate
+     * @param ms Calibration time; the caller sleeps meanwhile
+     */
+    void calibrate(uint32_t ms = 500);
+
+    /**
+     * @brief Start a measurement window
+     */
+    void start();
+
+    /**
+     * @brief End the measurement window
+     * @return Busy fraction 0.0 (idle) .. 1.0 (fully busy)
+     */
+    float stop();
+
+private:
+    TaskHandle_t _task;             ///< Counting task
+    volatile uint32_t _count;       ///< Incremented by the counting task
+    float _rate;                    ///< Idle counts per millisecond
+    uint32_t _startCount;           ///< _count at start()
+    uint32_t _startMs;              ///< millis() at start()
+
+    static void countTask(void* arg);
+};
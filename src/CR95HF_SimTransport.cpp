@@ -0,0 +1,851 @@
+/**
+ * @file    CR95HF_SimTransport.cpp
+ * @brief   Simulated CR95HF transport implementation
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#include "CR95HF_SimTransport.h"
+#include "CR95HF.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+/**
+ * @brief Construct simulator with an empty field and zero latency
+ */
+CR95HF_SimTransport::CR95HF_SimTransport()
+    : _tagCount(0), _vicinityCount(0), _invMaskBits(0), _invSlot(0xFF), _baud(57600), _proto(CR95HF_PROTO_OFF), _idle(false),
+      _detRef(0x70), _detDrop(0x20), _arcB(CR95HF_ARC_B_DEFAULT), _arcIndex(0),
+      _lossSeed(1), _turnaroundUs(0), _byteUs(0),
+      _airTime(false), _airUs(0),
+      _injectCode(0), _dropCount(0), _corruptIn(0), _corruptIndex(0), _corruptMask(0), _replay(NULL), _replayCount(0),
+      _replayPos(0), _replayErrors(0), _rxHead(0), _rxTail(0), _rxStart(0),
+      _commands(0), _flagErrors(0), _lastCmdLen(0)
+{
+}
+
+/**
+ * @brief Power-up: field off, every tag back to IDLE
+ * @return true
+ */
+bool CR95HF_SimTransport::begin() {
+    _idle = false;
+    _rxHead = _rxTail = 0;
+    fieldOff();
+    return true;
+}
+
+/**
+ * @brief RF field off: every tag loses power and its state
+ */
+void CR95HF_SimTransport::fieldOff() {
+    _proto = CR95HF_PROTO_OFF;
+    _invSlot = 0xFF;
+    for (uint8_t i = 0; i < _tagCount; i++) _tags[i].state = CR95HF_SIM_IDLE;
+    for (uint8_t i = 0; i < _vicinityCount; i++) _vicinity[i].quiet = false;
+}
+
+// ============================================================================
+// Field
+// ============================================================================
+
+/**
+ * @brief Put a tag in the field
+ * @param uid UID bytes
+ * @param uidLen 4, 7 or 10
+ * @param sak SAK of the last cascade level
+ * @param atqa ATQA, low byte first on air
+ * @return Tag index, or -1 if full / invalid
+ */
+int CR95HF_SimTransport::addTag(const uint8_t* uid, uint8_t uidLen, uint8_t sak,
+                                uint16_t atqa) {
+    if (_tagCount >= CR95HF_SIM_MAX_TAGS) return -1;
+    if (uidLen != 4 && uidLen != 7 && uidLen != 10) return -1;
+
+    CR95HF_SimTag& t = _tags[_tagCount];
+    memset(&t, 0, sizeof(t));
+    memcpy(t.uid, uid, uidLen);
+    t.uidLen = uidLen;
+    t.sak = sak;
+    t.atqa[0] = atqa & 0xFF;
+    t.atqa[1] = atqa >> 8;
+    t.state = CR95HF_SIM_IDLE;
+    t.present = true;
+    return _tagCount++;
+}
+
+/**
+ * @brief Put an ISO15693 tag in the field
+ * @param uid UID, LSB first
+ * @param blockSize Bytes per block
+ * @param blockCount Number of blocks
+ * @return Tag index, or -1 if full / memory too small
+ */
+int CR95HF_SimTransport::addVicinityTag(const uint8_t* uid, uint8_t blockSize,
+                                        uint8_t blockCount) {
+    if (_vicinityCount >= CR95HF_SIM_MAX_VICINITY) return -1;
+    if (blockSize * blockCount > CR95HF_SIM_VICINITY_MEM) return -1;
+
+    CR95HF_SimVicinityTag& t = _vicinity[_vicinityCount];
+    memset(&t, 0, sizeof(t));
+    memcpy(t.uid, uid, sizeof(t.uid));
+    t.blockSize = blockSize;
+    t.blockCount = blockCount;
+    t.present = true;
+    return _vicinityCount++;
+}
+
+/**
+ * @brief Take a tag out of the field
+ * @param index Tag index
+ */
+void CR95HF_SimTransport::removeTag(uint8_t index) {
+    if (index < _tagCount) _tags[index].present = false;
+}
+
+/**
+ * @brief Put a removed tag back in the field (IDLE state)
+ * @param index Tag index
+ */
+void CR95HF_SimTransport::restoreTag(uint8_t index) {
+    if (index >= _tagCount) return;
+    _tags[index].present = true;
+    _tags[index].state = CR95HF_SIM_IDLE;
+}
+
+/**
+ * @brief Cascade level bytes of a tag: 4 UID bytes (or CT + 3) + BCC
+ * @param t Tag
+ * @param level Cascade level (0-2)
+ * @param cl Output: 5 bytes
+ */
+void CR95HF_SimTransport::cascadeBytes(const CR95HF_SimTag& t, uint8_t level,
+                                       uint8_t* cl) const {
+    bool last = (level + 1 == levels(t));
+    uint8_t offset = level * 3;
+
+    if (last) {
+        memcpy(cl, &t.uid[offset], 4);
+    } else {
+        cl[0] = ISO14443A_CT;
+        memcpy(&cl[1], &t.uid[offset], 3);
+    }
+    cl[4] = cl[0] ^ cl[1] ^ cl[2] ^ cl[3];
+}
+
+/**
+ * @brief Index of the selected tag
+ * @return Tag index, or -1 if none is ACTIVE
+ */
+int CR95HF_SimTransport::activeTag() const {
+    for (uint8_t i = 0; i < _tagCount; i++) {
+        if (_tags[i].present && _tags[i].state == CR95HF_SIM_ACTIVE) return i;
+    }
+    return -1;
+}
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+/**
+ * @brief Replay a recorded trace instead of the model
+ * @param trace Exchanges in order
+ * @param count Number of exchanges (0 = model mode)
+ */
+void CR95HF_SimTransport::replay(const CR95HF_SimExchange* trace, uint16_t count) {
+    _replay = count ? trace : NULL;
+    _replayCount = count;
+    _replayPos = 0;
+    _replayErrors = 0;
+}
+
+// ============================================================================
+// Byte Stream
+// ============================================================================
+
+/**
+ * @brief Receive a command frame from the driver and prepare the answer
+ * @param data Frame bytes
+ * @param len Frame length
+ */
+void CR95HF_SimTransport::write(const uint8_t* data, size_t len) {
+    _commands++;
+    _lastCmdLen = (len < sizeof(_lastCmd)) ? len : sizeof(_lastCmd);
+    memcpy(_lastCmd, data, _lastCmdLen);
+    _rxHead = _rxTail = 0;
+    _rxStart = micros();
+    _airUs = 0;
+
+    if (_replay) {
+        if (_replayPos >= _replayCount) return;  // Past the recording: silence
+        const CR95HF_SimExchange& e = _replay[_replayPos++];
+        if (e.tx && (e.txLen != len || memcmp(e.tx, data, len) != 0)) _replayErrors++;
+        _rxTail = (e.rxLen < sizeof(_rx)) ? e.rxLen : sizeof(_rx);
+        if (e.rx) memcpy(_rx, e.rx, _rxTail); else _rxTail = 0;
+        return;
+    }
+
+    if (_idle) {
+        // Any UART activity pulls IRQ_IN low
+        wakeUp();
+    } else if (len == 1 && data[0] == CR95HF_CMD_ECHO) {
+        _rx[0] = CR95HF_CMD_ECHO;
+        _rxTail = 1;
+    } else if (len >= 2) {
+        uint8_t n = data[1];
+        if (n > len - 2) n = len - 2;
+        command(data[0], &data[2], n);
+    }
+
+    if (_dropCount) {
+        _dropCount--;
+        _rxTail = 0;
+    }
+}
+
+/**
+ * @brief Response bytes that have "arrived" given the configured latency
+ */
+int CR95HF_SimTransport::available() {
+    if (_rxHead >= _rxTail) return 0;
+
+    uint32_t elapsed = micros() - _rxStart;
+    uint32_t first = _turnaroundUs + _airUs;
+    if (elapsed < first) return 0;
+
+    uint32_t arrived = _rxTail;
+    if (_byteUs) {
+        arrived = 1 + (elapsed - first) / _byteUs;
+        if (arrived > _rxTail) arrived = _rxTail;
+    }
+    return (arrived > _rxHead) ? arrived - _rxHead : 0;
+}
+
+/**
+ * @brief Read next response byte
+ */
+int CR95HF_SimTransport::read() {
+    if (available() <= 0) return -1;
+    return _rx[_rxHead++];
+}
+
+/**
+ * @brief IRQ_IN pulse: leave Idle with wake-up source IRQ_IN
+ */
+void CR95HF_SimTransport::wakeUp() {
+    if (!_idle) return;
+    _idle = false;
+    uint8_t src = CR95HF_WU_IRQ_IN;
+    _rxStart = micros();
+    respond(CR95HF_RSP_SUCCESS, &src, 1);
+}
+
+// ============================================================================
+// Command Model
+// ============================================================================
+
+/**
+ * @brief Queue a framed response: code, length, payload
+ */
+void CR95HF_SimTransport::respond(uint8_t code, const uint8_t* data, uint16_t len) {
+    if (len > sizeof(_rx) - 2) len = sizeof(_rx) - 2;
+    _rx[0] = code;
+    _rx[1] = (uint8_t)len;
+    if (len) memcpy(&_rx[2], data, len);
+    _rxHead = 0;
+    _rxTail = len + 2;
+}
+
+/**
+ * @brief Queue a tag answer with the ISO14443-A status trailer
+ * @param data Tag bytes
+ * @param len Number of bytes
+ * @param lastBits Valid bits in the last byte (8 = full byte)
+ * @param collision Collision detected
+ * @param collByte Byte index of first collision
+ * @param collBit Bit index of first collision
+ */
+void CR95HF_SimTransport::respondTag(const uint8_t* data, uint8_t len, uint8_t lastBits,
+                                     bool collision, uint8_t collByte, uint8_t collBit) {
+    uint8_t buf[CR95HF_SIM_RX_MAX - 2];
+    if (len > sizeof(buf) - CR95HF_RX_TRAILER_LEN) len = sizeof(buf) - CR95HF_RX_TRAILER_LEN;
+
+    memcpy(buf, data, len);
+    if (_corruptIn && --_corruptIn == 0 && _corruptIndex < len) {
+        buf[_corruptIndex] ^= _corruptMask;
+    }
+    buf[len] = (collision ? CR95HF_RXFLAG_COLLISION : 0) | (lastBits & CR95HF_RXFLAG_BITS_MASK);
+    buf[len + 1] = collision ? collByte : 0;
+    buf[len + 2] = collision ? collBit : 0;
+    respond(CR95HF_RSP_DATA, buf, len + CR95HF_RX_TRAILER_LEN);
+}
+
+/**
+ * @brief Execute one CR95HF command
+ * @param cmd Command code
+ * @param payload Command payload
+ * @param len Payload length
+ */
+void CR95HF_SimTransport::command(uint8_t cmd, const uint8_t* payload, uint8_t len) {
+    switch (cmd) {
+        case CR95HF_CMD_IDN: {
+            uint8_t idn[sizeof(CR95HF_SIM_IDN) + 2];
+            memcpy(idn, CR95HF_SIM_IDN, sizeof(CR95HF_SIM_IDN));  // With NUL
+            uint16_t crc = crcA(idn, sizeof(CR95HF_SIM_IDN));
+            idn[sizeof(CR95HF_SIM_IDN)] = crc & 0xFF;
+            idn[sizeof(CR95HF_SIM_IDN) + 1] = crc >> 8;
+            respond(CR95HF_RSP_SUCCESS, idn, sizeof(idn));
+            break;
+        }
+
+        case CR95HF_CMD_PROTOCOL:
+            if (len < 1) {
+                respond(CR95HF_RSP_INVALID_LEN, NULL, 0);
+                break;
+            }
+            // Field off: tags lose power
+            if (payload[0] == CR95HF_PROTO_OFF) fieldOff();
+            _proto = payload[0];
+            _arcB = CR95HF_ARC_B_DEFAULT;   // Reloaded with the protocol
+            respond(CR95HF_RSP_SUCCESS, NULL, 0);
+            break;
+
+        case CR95HF_CMD_WRREG:
+            // 68 flags index [value]: set the ARC index, then write through it
+            if (len >= 3 && payload[0] == CR95HF_REG_ARC_INDEX) {
+                _arcIndex = payload[2];
+                if (len >= 4 && (payload[1] & CR95HF_REG_INC_ADDR) &&
+                    _arcIndex == CR95HF_ARC_B_INDEX) {
+                    _arcB = payload[3];
+                }
+                respond(CR95HF_RSP_SUCCESS, NULL, 0);
+            } else {
+                respond(CR95HF_RSP_INVALID_LEN, NULL, 0);
+            }
+            break;
+
+        case CR95HF_CMD_RDREG:
+            if (len >= 3 && payload[0] == CR95HF_REG_ARC_DATA) {
+                uint8_t v = (_arcIndex == CR95HF_ARC_B_INDEX) ? _arcB : 0x00;
+                respond(CR95HF_RSP_SUCCESS, &v, 1);
+            } else {
+                respond(CR95HF_RSP_INVALID_LEN, NULL, 0);
+            }
+            break;
+
+        case CR95HF_CMD_SENDRECV:
+            if (_proto == CR95HF_PROTO_OFF) {
+                respond(CR95HF_RSP_INVALID_LEN, NULL, 0);
+                break;
+            }
+            if (_injectCode) {
+                respond(_injectCode, NULL, 0);
+                _injectCode = 0;
+                break;
+            }
+            if (_analog && _proto == CR95HF_PROTO_ISO14443A) {
+                _lossSeed = _lossSeed * 1103515245u + 12345u;
+                if ((_lossSeed >> 16) % 100 < _analog(_arcB)) {
+                    respond(CR95HF_RSP_TIMEOUT, NULL, 0);   // Answer not decoded
+                    break;
+                }
+            }
+            if (_proto == CR95HF_PROTO_ISO15693) {
+                vicinity(payload, len);     // No flags byte; empty = EOF
+                if (_airTime) _airUs = airTime(len);
+            } else if (_proto != CR95HF_PROTO_ISO14443A) {
+                respond(CR95HF_RSP_TIMEOUT, NULL, 0);   // No ISO14443-B / FeliCa tags
+            } else if (len < 2) {
+                respond(CR95HF_RSP_INVALID_LEN, NULL, 0);
+            } else {
+                sendRecv(payload, len - 1, payload[len - 1]);
+                if (_airTime) _airUs = airTime(len - 1);
+            }
+            break;
+
+        case CR95HF_CMD_IDLE:
+            idle(payload, len);
+            break;
+
+        case CR95HF_CMD_BAUDRATE:
+            // Answered at the new rate; the driver discards it
+            _rx[0] = CR95HF_CMD_ECHO;
+            _rxTail = 1;
+            break;
+
+        default:
+            respond(CR95HF_RSP_INVALID_CMD, NULL, 0);
+            break;
+    }
+}
+
+/**
+ * @brief Idle command: calibration, tag detection or wait for IRQ_IN
+ * @param p Idle parameters (14 bytes, see CR95HF_Frame::buildIdle())
+ * @param len Parameter length
+ */
+void CR95HF_SimTransport::idle(const uint8_t* p, uint8_t len) {
+    if (len < 14) {
+        respond(CR95HF_RSP_INVALID_LEN, NULL, 0);
+        return;
+    }
+
+    // Field off while idle
+    fieldOff();
+
+    uint8_t wuSource = p[0];
+    uint16_t enterCtrl = p[1] | (p[2] << 8);
+    uint8_t dacL = p[10];
+    uint8_t dacH = p[11];
+
+    bool anyTag = false;
+    for (uint8_t i = 0; i < _tagCount; i++) anyTag |= _tags[i].present;
+    uint8_t level = _detRef;
+    if (anyTag) level = (_detRef > _detDrop) ? _detRef - _detDrop : 0;
+
+    bool detect;
+    if (enterCtrl == CR95HF_IDLE_ENTER_CALIB) {
+        detect = dacH < level;  // Calibration: only the high threshold moves
+    } else {
+        detect = level < dacL || level > dacH;
+    }
+
+    uint8_t src = 0;
+    if ((wuSource & CR95HF_WU_TAG_DETECT) && detect) {
+        src = CR95HF_WU_TAG_DETECT;
+    } else if (wuSource & CR95HF_WU_TIMEOUT) {
+        src = CR95HF_WU_TIMEOUT;
+    }
+
+    if (src) {
+        respond(CR95HF_RSP_SUCCESS, &src, 1);
+    } else {
+        _idle = true;       // Silent until wakeUp()
+    }
+}
+
+// ============================================================================
+// ISO14443-A Tag Model
+// ============================================================================
+
+/**
+ * @brief Dispatch a SendRecv RF frame
+ * @param rf RF bytes
+ * @param rfLen Number of RF bytes
+ * @param flags SendRecv transmit flags
+ */
+void CR95HF_SimTransport::sendRecv(const uint8_t* rf, uint8_t rfLen, uint8_t flags) {
+    // Wrong bit count or CRC: tags cannot decode the frame and stay silent
+    if (!flagsValid(rf, rfLen, flags)) {
+        _flagErrors++;
+        respond(CR95HF_RSP_TIMEOUT, NULL, 0);
+        return;
+    }
+
+    // REQA / WUPA: 7-bit short frame
+    if (rfLen == 1 && (rf[0] == ISO14443A_REQA || rf[0] == ISO14443A_WUPA)) {
+        wake(rf[0] == ISO14443A_WUPA);
+        return;
+    }
+
+    // Anticollision / SELECT
+    if (rfLen >= 2 && (rf[0] == ISO14443A_SEL_CL1 || rf[0] == ISO14443A_SEL_CL2 ||
+                       rf[0] == ISO14443A_SEL_CL3)) {
+        uint8_t level = (rf[0] - ISO14443A_SEL_CL1) / 2;
+        if (rf[1] == ISO14443A_NVB_SELECT && rfLen >= 7) {
+            select(level, &rf[2]);
+        } else {
+            uint8_t knownBits = ((rf[1] >> 4) - 2) * 8 + (rf[1] & 0x0F);
+            anticoll(level, &rf[2], knownBits > 40 ? 40 : knownBits);
+        }
+        return;
+    }
+
+    int active = activeTag();
+
+    // HLTA: selected tag goes silent, CR95HF reports a timeout
+    if (rfLen == 2 && rf[0] == ISO14443A_HLTA_B1 && rf[1] == ISO14443A_HLTA_B2) {
+        if (active >= 0) _tags[active].state = CR95HF_SIM_HALT;
+        respond(CR95HF_RSP_TIMEOUT, NULL, 0);
+        return;
+    }
+
+    // Anything else goes to the ACTIVE tag through the user handler
+    uint8_t resp[CR95HF_SIM_RX_MAX - 2 - CR95HF_RX_TRAILER_LEN - 2];
+    uint8_t respLen = sizeof(resp);
+    if (active < 0 || !_rfHandler || !_rfHandler(active, rf, rfLen, resp, respLen)) {
+        respond(CR95HF_RSP_TIMEOUT, NULL, 0);
+        return;
+    }
+    if (respLen > sizeof(resp)) respLen = sizeof(resp);
+    if (flags & CR95HF_TXFLAG_CRC) {
+        uint16_t crc = crcA(resp, respLen);
+        resp[respLen++] = crc & 0xFF;
+        resp[respLen++] = crc >> 8;
+    }
+    respondTag(resp, respLen, 8, false, 0, 0);
+}
+
+/**
+ * @brief Check SendRecv flags against the ISO14443-A frame they go with
+ * @param rf RF bytes
+ * @param rfLen Number of RF bytes
+ * @param flags SendRecv transmit flags
+ * @return true if the CR95HF would put the frame on air as intended
+ *
+ * REQA / WUPA: 7 bits, no CRC. Anticollision: the NVB bit count (8 when
+ * it is 0), no CRC. SELECT: 8 bits with CRC. Anything else: whole bytes.
+ */
+bool CR95HF_SimTransport::flagsValid(const uint8_t* rf, uint8_t rfLen, uint8_t flags) {
+    uint8_t bits = flags & CR95HF_TXFLAG_BITS_MASK;
+    bool crc = flags & CR95HF_TXFLAG_CRC;
+
+    if (rfLen == 1 && (rf[0] == ISO14443A_REQA || rf[0] == ISO14443A_WUPA)) {
+        return bits == 7 && !crc;
+    }
+    if (rfLen >= 2 && (rf[0] == ISO14443A_SEL_CL1 || rf[0] == ISO14443A_SEL_CL2 ||
+                       rf[0] == ISO14443A_SEL_CL3)) {
+        if (rf[1] == ISO14443A_NVB_SELECT) return bits == 8 && crc;
+        uint8_t nvbBits = rf[1] & 0x0F;
+        return bits == (nvbBits ? nvbBits : 8) && !crc;
+    }
+    return bits == 8;
+}
+
+/**
+ * @brief RF air time of the exchange just answered
+ * @param txRf RF bytes sent
+ * @return Microseconds: command with CRC, tag answer, frame overheads
+ */
+uint32_t CR95HF_SimTransport::airTime(uint8_t txRf) const {
+    bool vicinity = _proto == CR95HF_PROTO_ISO15693;
+    uint8_t trailer = vicinity ? CR95HF_RX15_TRAILER_LEN : CR95HF_RX_TRAILER_LEN;
+
+    uint32_t bytes = txRf + 2;
+    if (_rxTail > 2 && _rx[0] == CR95HF_RSP_DATA && _rx[1] > trailer) {
+        bytes += _rx[1] - trailer;
+    }
+    if (vicinity) return bytes * CR95HF_RF_BYTE_US_15693 + 2 * CR95HF_RF_FRAME_US_15693;
+    return bytes * CR95HF_RF_BYTE_US_A + 2 * CR95HF_RF_FRAME_US_A;
+}
+
+/**
+ * @brief REQA / WUPA: wake tags, answer with (merged) ATQA
+ * @param all true for WUPA (also wakes halted tags)
+ */
+void CR95HF_SimTransport::wake(bool all) {
+    uint8_t atqa[2] = {0, 0};
+    uint8_t diff = 0;
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < _tagCount; i++) {
+        CR95HF_SimTag& t = _tags[i];
+        if (!t.present) continue;
+        if (t.state == CR95HF_SIM_HALT && !all) continue;
+
+        t.fromHalt = (t.state == CR95HF_SIM_HALT);
+        t.state = CR95HF_SIM_READY;
+        t.level = 0;
+
+        if (n) diff |= (atqa[0] ^ t.atqa[0]) | (atqa[1] ^ t.atqa[1]);
+        atqa[0] |= t.atqa[0];
+        atqa[1] |= t.atqa[1];
+        n++;
+    }
+
+    if (n == 0) {
+        respond(CR95HF_RSP_TIMEOUT, NULL, 0);
+        return;
+    }
+    respondTag(atqa, 2, 8, diff != 0, 0, 0);
+}
+
+/**
+ * @brief Bit-oriented anticollision at one cascade level
+ * @param level Cascade level (0-2)
+ * @param known Known UID bits (LSB first)
+ * @param knownBits Number of known bits
+ *
+ * READY tags whose cascade bytes start with the known bits answer with the
+ * remaining bits; the first bit where they disagree is reported as the
+ * collision position, relative to the first received bit.
+ */
+void CR95HF_SimTransport::anticoll(uint8_t level, const uint8_t* known, uint8_t knownBits) {
+    uint8_t cl[CR95HF_SIM_MAX_TAGS][5];
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < _tagCount; i++) {
+        const CR95HF_SimTag& t = _tags[i];
+        if (!t.present || t.state != CR95HF_SIM_READY || t.level != level) continue;
+
+        cascadeBytes(t, level, cl[n]);
+        bool match = true;
+        for (uint8_t b = 0; b < knownBits && match; b++) {
+            match = ((cl[n][b / 8] ^ known[b / 8]) >> (b % 8) & 0x01) == 0;
+        }
+        if (match) n++;
+    }
+
+    if (n == 0) {
+        respond(CR95HF_RSP_TIMEOUT, NULL, 0);
+        return;
+    }
+
+    uint8_t coll = 40;
+    for (uint8_t b = knownBits; b < 40 && coll == 40; b++) {
+        uint8_t v = (cl[0][b / 8] >> (b % 8)) & 0x01;
+        for (uint8_t k = 1; k < n; k++) {
+            if (((cl[k][b / 8] >> (b % 8)) & 0x01) != v) {
+                coll = b;
+                break;
+            }
+        }
+    }
+
+    // Remaining bits of the first candidate, packed from bit 0
+    uint8_t out[5] = {0};
+    uint8_t bits = 40 - knownBits;
+    for (uint8_t k = 0; k < bits; k++) {
+        uint8_t b = knownBits + k;
+        if ((cl[0][b / 8] >> (b % 8)) & 0x01) out[k / 8] |= 1 << (k % 8);
+    }
+
+    uint8_t rel = coll - knownBits;
+    respondTag(out, (bits + 7) / 8, (bits % 8) ? bits % 8 : 8, coll < 40, rel / 8, rel % 8);
+}
+
+/**
+ * @brief SELECT at one cascade level
+ * @param level Cascade level (0-2)
+ * @param cl 4 UID bytes + BCC
+ */
+void CR95HF_SimTransport::select(uint8_t level, const uint8_t* cl) {
+    int chosen = -1;
+
+    for (uint8_t i = 0; i < _tagCount; i++) {
+        CR95HF_SimTag& t = _tags[i];
+        if (!t.present || t.state != CR95HF_SIM_READY || t.level != level) continue;
+
+        uint8_t mine[5];
+        cascadeBytes(t, level, mine);
+        if (chosen < 0 && memcmp(mine, cl, 5) == 0) {
+            chosen = i;
+        } else {
+            // Not addressed: back to IDLE (or HALT if woken from there)
+            t.state = t.fromHalt ? CR95HF_SIM_HALT : CR95HF_SIM_IDLE;
+        }
+    }
+
+    if (chosen < 0) {
+        respond(CR95HF_RSP_TIMEOUT, NULL, 0);
+        return;
+    }
+
+    CR95HF_SimTag& t = _tags[chosen];
+    uint8_t sak;
+    if (level + 1 < levels(t)) {
+        t.level++;
+        sak = 0x04;     // Cascade bit: UID not complete
+    } else {
+        t.state = CR95HF_SIM_ACTIVE;
+        sak = t.sak;
+    }
+
+    uint8_t resp[3] = {sak, 0, 0};
+    uint16_t crc = crcA(resp, 1);
+    resp[1] = crc & 0xFF;
+    resp[2] = crc >> 8;
+    respondTag(resp, 3, 8, false, 0, 0);
+}
+
+// ============================================================================
+// ISO15693 Tag Model
+// ============================================================================
+
+/**
+ * @brief Dispatch an ISO15693 request (or EOF)
+ * @param rf Request bytes
+ * @param len Number of bytes (0 = EOF: next inventory slot)
+ */
+void CR95HF_SimTransport::vicinity(const uint8_t* rf, uint8_t len) {
+    if (len == 0) {
+        if (_invSlot >= ISO15693_SLOTS - 1) {
+            _invSlot = 0xFF;
+            respond(CR95HF_RSP_TIMEOUT, NULL, 0);
+            return;
+        }
+        vicinitySlot(++_invSlot);
+        return;
+    }
+    _invSlot = 0xFF;   // Any request ends a 16-slot round
+
+    uint8_t flags = rf[0];
+    if ((flags & ISO15693_FLAG_INVENTORY) && len >= 3 && rf[1] == ISO15693_CMD_INVENTORY) {
+        _invMaskBits = rf[2];
+        uint8_t maskBytes = (_invMaskBits + 7) / 8;
+        if (_invMaskBits > 64 || len < 3 + maskBytes) {
+            respond(CR95HF_RSP_TIMEOUT, NULL, 0);
+            return;
+        }
+        memset(_invMask, 0, sizeof(_invMask));
+        memcpy(_invMask, &rf[3], maskBytes);
+
+        if (flags & ISO15693_FLAG_1_SLOT) {
+            vicinitySlot(-1);
+        } else {
+            _invSlot = 0;
+            vicinitySlot(0);
+        }
+        return;
+    }
+
+    // Addressed: UID after the command; otherwise any tag not quiet
+    int t = -1;
+    const uint8_t* args = &rf[2];
+    uint8_t argLen = (len > 2) ? len - 2 : 0;
+    for (uint8_t i = 0; i < _vicinityCount && t < 0 && len >= 2; i++) {
+        const CR95HF_SimVicinityTag& v = _vicinity[i];
+        if (!v.present) continue;
+        if (flags & ISO15693_FLAG_ADDRESS) {
+            if (len >= 2 + sizeof(v.uid) && memcmp(v.uid, &rf[2], sizeof(v.uid)) == 0) t = i;
+        } else if (!v.quiet) {
+            t = i;
+        }
+    }
+    if (flags & ISO15693_FLAG_ADDRESS) {
+        args += sizeof(_vicinity[0].uid);
+        argLen = (argLen > sizeof(_vicinity[0].uid)) ? argLen - sizeof(_vicinity[0].uid) : 0;
+    }
+    if (t < 0) {
+        respond(CR95HF_RSP_TIMEOUT, NULL, 0);
+        return;
+    }
+
+    CR95HF_SimVicinityTag& v = _vicinity[t];
+    uint8_t resp[1 + CR95HF_SIM_VICINITY_MEM];
+    switch (rf[1]) {
+        case ISO15693_CMD_STAY_QUIET:
+            v.quiet = true;
+            respond(CR95HF_RSP_TIMEOUT, NULL, 0);   // No answer by definition
+            return;
+
+        case ISO15693_CMD_READ_MULTI: {
+            uint16_t first = argLen >= 2 ? args[0] : 0xFFFF;
+            uint16_t count = argLen >= 2 ? args[1] + 1 : 0;
+            if (first + count > v.blockCount) {
+                uint8_t err[2] = {ISO15693_FLAG_ERROR, 0x10};  // Block not available
+                respondVicinity(err, sizeof(err));
+                return;
+            }
+            resp[0] = 0x00;
+            memcpy(&resp[1], &v.memory[first * v.blockSize], count * v.blockSize);
+            respondVicinity(resp, 1 + count * v.blockSize);
+            return;
+        }
+
+        default: {
+            uint8_t err[2] = {ISO15693_FLAG_ERROR, 0x01};      // Not supported
+            respondVicinity(err, sizeof(err));
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Answer one inventory slot
+ * @param slot Slot number (0-15), -1 for a 1-slot request
+ *
+ * Tags not quiet whose UID starts with the mask (and continues with the
+ * slot number) answer. Several at once come out as an RF error.
+ */
+void CR95HF_SimTransport::vicinitySlot(int slot) {
+    int hit = -1;
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < _vicinityCount; i++) {
+        const CR95HF_SimVicinityTag& v = _vicinity[i];
+        if (!v.present || v.quiet) continue;
+
+        bool match = true;
+        for (uint8_t b = 0; b < _invMaskBits && match; b++) {
+            match = ((v.uid[b / 8] ^ _invMask[b / 8]) >> (b % 8) & 0x01) == 0;
+        }
+        if (match && slot >= 0 && _invMaskBits + 4 <= 64) {
+            match = ((v.uid[_invMaskBits / 8] >> (_invMaskBits % 8)) & 0x0F) == slot;
+        }
+        if (match) {
+            if (hit < 0) hit = i;
+            n++;
+        }
+    }
+
+    if (n == 0) {
+        respond(CR95HF_RSP_TIMEOUT, NULL, 0);
+    } else if (n > 1) {
+        respond(CR95HF_RSP_COLLISION, NULL, 0);
+    } else {
+        uint8_t resp[2 + 8] = {0x00, _vicinity[hit].dsfid};
+        memcpy(&resp[2], _vicinity[hit].uid, 8);
+        respondVicinity(resp, sizeof(resp));
+    }
+}
+
+/**
+ * @brief Queue an ISO15693 tag answer: data, CRC, status byte
+ * @param data Tag bytes (without CRC)
+ * @param len Number of bytes
+ */
+void CR95HF_SimTransport::respondVicinity(const uint8_t* data, uint8_t len) {
+    uint8_t buf[CR95HF_SIM_RX_MAX - 2];
+    if (len > sizeof(buf) - 2 - CR95HF_RX15_TRAILER_LEN) {
+        len = sizeof(buf) - 2 - CR95HF_RX15_TRAILER_LEN;
+    }
+
+    memcpy(buf, data, len);
+    uint16_t crc = crc15693(data, len);
+    buf[len] = crc & 0xFF;
+    buf[len + 1] = crc >> 8;
+    buf[len + 2] = 0x00;    // Status: no collision, CRC ok
+    respond(CR95HF_RSP_DATA, buf, len + 2 + CR95HF_RX15_TRAILER_LEN);
+}
+
+// ============================================================================
+// CRC
+// ============================================================================
+
+/**
+ * @brief CRC_A (ISO14443-3 Annex B)
+ * @param data Bytes
+ * @param len Number of bytes
+ * @return CRC, low byte sent first
+ */
+uint16_t CR95HF_SimTransport::crcA(const uint8_t* data, uint16_t len) {
+    uint16_t crc = 0x6363;
+    for (uint16_t i = 0; i < len; i++) {
+        uint8_t b = data[i] ^ (uint8_t)(crc & 0xFF);
+        b ^= b << 4;
+        crc = (crc >> 8) ^ ((uint16_t)b << 8) ^ ((uint16_t)b << 3) ^ (b >> 4);
+    }
+    return crc;
+}
+
+/**
+ * @brief ISO15693 CRC (ISO/IEC 13239: poly 0x8408 reflected, inverted)
+ * @param data Bytes
+ * @param len Number of bytes
+ * @return CRC, low byte sent first
+ */
+uint16_t CR95HF_SimTransport::crc15693(const uint8_t* data, uint16_t len) {
+    uint16_t crc = 0xFFFF;
+    for (uint16_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t b = 0; b < 8; b++) crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+    }
+    return ~crc;
+}
@@ -0,0 +1,394 @@
+/**
+ * @file    CR95HF_SimTransport.h
+ * @brief   Simulated CR95HF transport for off-target tests and benchmarks
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * Emulates a CR95HF behind the CR95HF_Transport byte stream, so CR95HF.cpp
+ * runs unchanged without hardware. On a PC, extras/host supplies the parts
+ * of the Arduino-ESP32 core the driver needs (timing, Print /
+ * HardwareSerial, FreeRTOS tasks and semaphores) and runs sim_test.cpp.
+ *
+ * Two modes:
+ * - Model: a CR95HF in ISO14443-A reader mode with simulated tags in the
+ *   field. REQA / WUPA, bit-level anticollision with collision reporting,
+ *   SELECT over all cascade levels and HLTA follow ISO14443-3 tag states.
+ *   SendRecv flags (last-byte bit count, CRC) are checked per frame type;
+ *   a frame with wrong flags gets no tag answer and is counted.
+ *   Other RF commands go to a user handler. In ISO15693 mode, vicinity
+ *   tags answer 1-slot / 16-slot inventory, STAY QUIET and READ MULTIPLE
+ *   BLOCKS.
+ * - Replay: answers each command with the next response of a recorded
+ *   trace and counts commands that differ from the recording.
+ *
+ * Response framing is the real one (code, length, payload, ISO14443-A
+ * status trailer). Fault injection forces CR95HF_RSP_TIMEOUT / COLLISION /
+ * FRAMEERR or a missing answer; latency per response and per byte is
+ * configurable.
+ *
+ * @code
+ * #include <CR95HF.h>
+ * #include <CR95HF_SimTransport.h>
+ *
+ * CR95HF_SimTransport sim;
+ * CR95HF nfc(sim);
+ *
+ * static const uint8_t uid[] = {0x04, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+ * sim.addTag(uid, sizeof(uid), SAK_MIFARE_UL, 0x0044);
+ * nfc.begin();
+ * nfc.iso14443aGetUID(out, outLen, sak);   // outLen == 7
+ * @endcode
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#pragma once
+
+#include "CR95HF_Transport.h"
+#include <functional>
+
+/// Simulated tags in the field at once
+#ifndef CR95HF_SIM_MAX_TAGS
+#define CR95HF_SIM_MAX_TAGS     4
+#endif
+
+/// Simulated ISO15693 tags in the field at once
+#ifndef CR95HF_SIM_MAX_VICINITY
+#define CR95HF_SIM_MAX_VICINITY 16
+#endif
+
+/// Memory per simulated ISO15693 tag (bytes)
+#ifndef CR95HF_SIM_VICINITY_MEM
+#define CR95HF_SIM_VICINITY_MEM 128
+#endif
+
+/// Largest simulated response (code + length + 255 data bytes)
+#define CR95HF_SIM_RX_MAX       258
+
+/// Device identification string reported by IDN
+#define CR95HF_SIM_IDN          "NFC FS2JAST4"
+
+// ============================================================================
+// Simulation Types
+// ============================================================================
+
+/**
+ * @brief ISO14443-3 tag states
+ */
+enum CR95HF_SimTagState : uint8_t {
+    CR95HF_SIM_IDLE = 0,    ///< Powered, waiting for REQA / WUPA
+    CR95HF_SIM_READY,       ///< Woken, taking part in anticollision
+    CR95HF_SIM_ACTIVE,      ///< Selected
+    CR95HF_SIM_HALT         ///< Halted, only WUPA wakes it
+};
+
+/**
+ * @brief Simulated ISO14443-A tag
+ */
+struct CR95HF_SimTag {
+    uint8_t uid[10];            ///< UID (4, 7 or 10 bytes)
+    uint8_t uidLen;             ///< UID length
+    uint8_t sak;                ///< SAK of the last cascade level
+    uint8_t atqa[2];            ///< ATQA (LSB first)
+    uint8_t state;              ///< CR95HF_SimTagState
+    uint8_t level;              ///< Current cascade level (0-2)
+    bool fromHalt;              ///< Woken from HALT (falls back to HALT)
+    bool present;               ///< In the field
+};
+
+/**
+ * @brief Simulated ISO15693 tag
+ */
+struct CR95HF_SimVicinityTag {
+    uint8_t uid[8];             ///< UID, LSB first as on air
+    uint8_t dsfid;              ///< DSFID reported by inventory
+    uint8_t blockSize;          ///< Bytes per block
+    uint8_t blockCount;         ///< Blocks (blockSize * blockCount <= CR95HF_SIM_VICINITY_MEM)
+    uint8_t memory[CR95HF_SIM_VICINITY_MEM];   ///< Block contents
+    bool quiet;                 ///< Sent STAY QUIET (until field off)
+    bool present;               ///< In the field
+};
+
+/**
+ * @brief Analog front-end model: share of tag answers lost per ARC_B
+ * @param arcB Current ARC_B register value
+ * @return Percentage of SendRecv answers lost (0-100)
+ */
+typedef std::function<uint8_t(uint8_t arcB)> CR95HF_SimAnalogModel;
+
+/**
+ * @brief One recorded exchange for replay
+ *
+ * tx is compared with the command sent by the driver (NULL = don't check),
+ * rx is the raw response: code, length, payload (NULL = no answer).
+ */
+struct CR95HF_SimExchange {
+    const uint8_t* tx;          ///< Expected command frame
+    uint8_t txLen;              ///< Expected command length
+    const uint8_t* rx;          ///< Raw response bytes
+    uint16_t rxLen;             ///< Raw response length
+};
+
+/**
+ * @brief Handler for RF commands the model does not know (READ, etc.)
+ * @param tag Index of the ACTIVE tag
+ * @param rf RF bytes sent (without CRC)
+ * @param rfLen Number of RF bytes
+ * @param resp Output: tag answer (without CRC)
+ * @param respLen Input: capacity, Output: answer length
+ * @return false if the tag stays silent
+ */
+typedef std::function<bool(uint8_t tag, const uint8_t* rf, uint8_t rfLen,
+                           uint8_t* resp, uint8_t& respLen)> CR95HF_SimRfHandler;
+
+// ============================================================================
+// CR95HF_SimTransport - Simulated CR95HF
+// ============================================================================
+
+/**
+ * @class   CR95HF_SimTransport
+ * @brief   CR95HF emulation behind the transport interface
+ */
+class CR95HF_SimTransport : public CR95HF_Transport {
+public:
+    CR95HF_SimTransport();
+
+    bool begin() override;
+    void write(const uint8_t* data, size_t len) override;
+    int available() override;
+    int read() override;
+    void flushRx() override { _rxHead = _rxTail = 0; }
+    void wakeUp() override;
+    bool setBaudRate(uint32_t baud) override { _baud = baud; return true; }
+    uint32_t baudRate() const override { return _baud; }
+
+    // ------------------------------------------------------------------------
+    // Field
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Put a tag in the field
+     * @param uid UID bytes
+     * @param uidLen 4, 7 or 10
+     * @param sak SAK of the last cascade level
+     * @param atqa ATQA, low byte first on air (e.g. 0x0044)
+     * @return Tag index, or -1 if full / invalid
+     */
+    int addTag(const uint8_t* uid, uint8_t uidLen, uint8_t sak, uint16_t atqa);
+
+    /**
+     * @brief Take a tag out of the field (index stays valid)
+     */
+    void removeTag(uint8_t index);
+
+    /**
+     * @brief Put a removed tag back (enters the field in IDLE state)
+     */
+    void restoreTag(uint8_t index);
+
+    /**
+     * @brief Remove all tags
+     */
+    void clearTags() { _tagCount = 0; }
+
+    /**
+     * @brief Tag by index (state inspection in tests)
+     */
+    const CR95HF_SimTag& tag(uint8_t index) const { return _tags[index]; }
+
+    /**
+     * @brief Put an ISO15693 tag in the field
+     * @param uid UID, LSB first (uid[7] = 0xE0)
+     * @param blockSize Bytes per block
+     * @param blockCount Number of blocks
+     * @return Tag index, or -1 if full / memory too small
+     */
+    int addVicinityTag(const uint8_t* uid, uint8_t blockSize = 4, uint8_t blockCount = 28);
+
+    /**
+     * @brief ISO15693 tag by index (e.g. to fill its memory)
+     */
+    CR95HF_SimVicinityTag& vicinityTag(uint8_t index) { return _vicinity[index]; }
+
+    /**
+     * @brief Remove all ISO15693 tags
+     */
+    void clearVicinityTags() { _vicinityCount = 0; }
+
+    /**
+     * @brief Set handler for RF commands the model does not know
+     */
+    void onRfCommand(CR95HF_SimRfHandler handler) { _rfHandler = handler; }
+
+    /**
+     * @brief Tag detector level: calibration reference and drop with a tag
+     * @param ref DAC value the empty field measures as
+     * @param tagDrop How much a tag in the field lowers the value
+     */
+    void setDetectorLevel(uint8_t ref, uint8_t tagDrop = 0x20) {
+        _detRef = ref;
+        _detDrop = tagDrop;
+    }
+
+    /**
+     * @brief Make reception depend on ARC_B (marginal antenna)
+     * @param model Loss percentage per ARC_B value (empty = no losses)
+     */
+    void setAnalogModel(CR95HF_SimAnalogModel model) { _analog = model; }
+
+    /**
+     * @brief Current ARC_B register value
+     */
+    uint8_t arcB() const { return _arcB; }
+
+    // ------------------------------------------------------------------------
+    // Timing and faults
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Response latency
+     * @param turnaroundUs Time from command to first response byte
+     * @param byteUs Time per further response byte (0 = all at once)
+     */
+    void setLatency(uint32_t turnaroundUs, uint32_t byteUs) {
+        _turnaroundUs = turnaroundUs;
+        _byteUs = byteUs;
+    }
+
+    /**
+     * @brief Add RF air time to SendRecv answers (on top of setLatency())
+     * @param enable Delay each answer by command and tag frame on air
+     *               (CR95HF_RF_BYTE_US_A / _15693 per byte)
+     */
+    void setAirTime(bool enable) { _airTime = enable; }
+
+    /**
+     * @brief Answer the next SendRecv with a bare response code
+     * @param code e.g. CR95HF_RSP_TIMEOUT, CR95HF_RSP_COLLISION, CR95HF_RSP_FRAMEERR
+     */
+    void injectResponse(uint8_t code) { _injectCode = code; }
+
+    /**
+     * @brief Flip bits in an upcoming ISO14443-A tag answer (RF noise)
+     * @param nth Tag answers to let through first (0 = the next one)
+     * @param index Byte of the answer to corrupt
+     * @param mask Bits to flip
+     */
+    void corruptAnswer(uint8_t nth, uint8_t index, uint8_t mask) {
+        _corruptIn = nth + 1;
+        _corruptIndex = index;
+        _corruptMask = mask;
+    }
+
+    /**
+     * @brief Send no answer at all to the next commands (host-side timeout)
+     * @param count Number of commands to leave unanswered
+     */
+    void dropResponses(uint8_t count = 1) { _dropCount = count; }
+
+    // ------------------------------------------------------------------------
+    // Replay
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Replay a recorded trace instead of the model
+     * @param trace Exchanges in order (must stay valid)
+     * @param count Number of exchanges (0 = back to model mode)
+     */
+    void replay(const CR95HF_SimExchange* trace, uint16_t count);
+
+    /**
+     * @brief Replay finished (every exchange consumed)
+     */
+    bool replayDone() const { return _replayPos >= _replayCount; }
+
+    /**
+     * @brief Commands that differed from the recording
+     */
+    uint16_t replayMismatches() const { return _replayErrors; }
+
+    // ------------------------------------------------------------------------
+    // Inspection
+    // ------------------------------------------------------------------------
+
+    uint32_t commandCount() const { return _commands; }     ///< Frames received
+    uint32_t flagErrors() const { return _flagErrors; }     ///< SendRecv frames with wrong flags
+    const uint8_t* lastCommand() const { return _lastCmd; } ///< Last frame received
+    uint8_t lastCommandLen() const { return _lastCmdLen; }  ///< Its length
+
+    /**
+     * @brief CRC_A (ISO14443-3), as appended to tag answers
+     */
+    static uint16_t crcA(const uint8_t* data, uint16_t len);
+
+    /**
+     * @brief ISO15693 CRC (ISO/IEC 13239), as appended to tag answers
+     */
+    static uint16_t crc15693(const uint8_t* data, uint16_t len);
+
+private:
+    CR95HF_SimTag _tags[CR95HF_SIM_MAX_TAGS];  ///< Simulated tags
+    uint8_t _tagCount;              ///< Tags added
+    CR95HF_SimRfHandler _rfHandler; ///< Unknown RF command handler
+
+    CR95HF_SimVicinityTag _vicinity[CR95HF_SIM_MAX_VICINITY];  ///< ISO15693 tags
+    uint8_t _vicinityCount;         ///< ISO15693 tags added
+    uint8_t _invMask[8];            ///< 16-slot inventory mask
+    uint8_t _invMaskBits;           ///< Its length in bits
+    uint8_t _invSlot;               ///< Current slot (0xFF = no round)
+
+    uint32_t _baud;                 ///< Nominal baud rate (reported only)
+    uint8_t _proto;                 ///< Selected protocol (CR95HF_PROTO_*)
+    bool _idle;                     ///< In Idle, waiting for IRQ_IN
+    uint8_t _detRef;                ///< Tag detector reference
+    uint8_t _detDrop;               ///< Tag detector drop per tag
+    uint8_t _arcB;                  ///< ARC_B register
+    uint8_t _arcIndex;              ///< ARC register index
+    CR95HF_SimAnalogModel _analog;  ///< Losses per ARC_B
+    uint32_t _lossSeed;             ///< Loss pseudo-random state
+
+    uint32_t _turnaroundUs;         ///< Command to first byte
+    uint32_t _byteUs;               ///< Per byte after the first
+    bool _airTime;                  ///< Model RF air time
+    uint32_t _airUs;                ///< Air time of the pending answer
+    uint8_t _injectCode;            ///< Forced response code (0 = none)
+    uint8_t _dropCount;             ///< Commands left unanswered
+    uint8_t _corruptIn;             ///< Tag answers until the corrupted one (0 = none)
+    uint8_t _corruptIndex;          ///< Byte to corrupt
+    uint8_t _corruptMask;           ///< Bits to flip
+
+    const CR95HF_SimExchange* _replay;  ///< Trace being replayed
+    uint16_t _replayCount;          ///< Exchanges in trace
+    uint16_t _replayPos;            ///< Next exchange
+    uint16_t _replayErrors;         ///< Mismatching commands
+
+    uint8_t _rx[CR95HF_SIM_RX_MAX]; ///< Pending response
+    uint16_t _rxHead;               ///< Next byte to read
+    uint16_t _rxTail;               ///< End of response
+    uint32_t _rxStart;              ///< micros() at command
+
+    uint32_t _commands;             ///< Frames received
+    uint32_t _flagErrors;           ///< SendRecv frames with wrong flags
+    uint8_t _lastCmd[32];           ///< Last frame (truncated)
+    uint8_t _lastCmdLen;            ///< Its length
+
+    void respond(uint8_t code, const uint8_t* data, uint16_t len);
+    void respondTag(const uint8_t* data, uint8_t len, uint8_t lastBits,
+                    bool collision, uint8_t collByte, uint8_t collBit);
+    void command(uint8_t cmd, const uint8_t* payload, uint8_t len);
+    void sendRecv(const uint8_t* rf, uint8_t rfLen, uint8_t flags);
+    uint32_t airTime(uint8_t txRf) const;
+    static bool flagsValid(const uint8_t* rf, uint8_t rfLen, uint8_t flags);
+    void idle(const uint8_t* payload, uint8_t len);
+    void wake(bool all);
+    void anticoll(uint8_t level, const uint8_t* known, uint8_t knownBits);
+    void select(uint8_t level, const uint8_t* cl);
+    void cascadeBytes(const CR95HF_SimTag& t, uint8_t level, uint8_t* cl) const;
+    uint8_t levels(const CR95HF_SimTag& t) const { return t.uidLen == 4 ? 1 : t.uidLen == 7 ? 2 : 3; }
+    int activeTag() const;
+    void vicinity(const uint8_t* rf, uint8_t len);
+    void vicinitySlot(int slot);
+    void respondVicinity(const uint8_t* data, uint8_t len);
+    void fieldOff();
+};
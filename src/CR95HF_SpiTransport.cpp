@@ -0,0 +1,319 @@
+/**
+ * @file    CR95HF_SpiTransport.cpp
+ * @brief   CR95HF SPI transport implementation
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#include "CR95HF_SpiTransport.h"
+#include "CR95HF.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+/// Offset of the response code in _rxBuf (payload then starts word aligned)
+#define SPI_RX_HDR  2
+/// Offset of the response payload in _rxBuf (SPI_RX_HDR + code + length)
+#define SPI_RX_DATA 4
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+/**
+ * @brief Construct SPI transport
+ * @param host SPI host
+ * @param sckPin SPI clock pin
+ * @param misoPin SPI MISO pin
+ * @param mosiPin SPI MOSI pin
+ * @param csPin Chip select pin
+ * @param irqInPin IRQ_IN pin
+ * @param irqOutPin IRQ_OUT pin (-1 = poll flags)
+ * @param clockHz SPI clock frequency
+ */
+CR95HF_SpiTransport::CR95HF_SpiTransport(spi_host_device_t host, int sckPin, int misoPin,
+                                         int mosiPin, int csPin, int irqInPin,
+                                         int irqOutPin, uint32_t clockHz)
+    : _host(host), _sckPin(sckPin), _misoPin(misoPin), _mosiPin(mosiPin),
+      _csPin(csPin), _irqInPin(irqInPin), _irqOutPin(irqOutPin),
+      _clockHz(clockHz), _dev(NULL), _rxEvents(false), _irqSem(NULL),
+      _rxHead(0), _rxTail(0)
+{
+}
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+/**
+ * @brief Start SPI bus (DMA enabled), reset and wake the CR95HF
+ * @return true if SPI bus and device configured
+ */
+bool CR95HF_SpiTransport::begin() {
+    pinMode(_csPin, OUTPUT);
+    digitalWrite(_csPin, HIGH);
+    pinMode(_irqInPin, OUTPUT);
+    digitalWrite(_irqInPin, HIGH);
+    if (_irqOutPin >= 0) pinMode(_irqOutPin, INPUT_PULLUP);
+
+    if (_dev == NULL) {
+        spi_bus_config_t bus = {};
+        bus.mosi_io_num = _mosiPin;
+        bus.miso_io_num = _misoPin;
+        bus.sclk_io_num = _sckPin;
+        bus.quadwp_io_num = -1;
+        bus.quadhd_io_num = -1;
+        bus.max_transfer_sz = CR95HF_SPI_MAX_FRAME;
+
+        // ESP_ERR_INVALID_STATE: bus already set up by another device
+        esp_err_t err = spi_bus_initialize(_host, &bus, SPI_DMA_CH_AUTO);
+        if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) return false;
+
+        spi_device_interface_config_t dev = {};
+        dev.clock_speed_hz = (int)_clockHz;
+        dev.mode = 0;
+        dev.spics_io_num = -1;  // /SS driven manually to span transactions
+        dev.queue_size = 1;
+        if (spi_bus_add_device(_host, &dev, &_dev) != ESP_OK) {
+            _dev = NULL;
+            return false;
+        }
+    }
+
+    reset();
+    return true;
+}
+
+/**
+ * @brief Send SPI reset control byte and wake the CR95HF again
+ */
+void CR95HF_SpiTransport::reset() {
+    _txBuf[0] = CR95HF_SPI_RESET;
+    if (select()) {
+        transfer(_txBuf, NULL, 1, false);
+        deselect();
+    }
+    delay(1);
+
+    wakeUp();
+    _rxHead = _rxTail = 0;
+}
+
+/**
+ * @brief Pulse IRQ_IN low to leave power-up / IDLE state
+ *
+ * Datasheet: pulse >= 10 us, then >= 10 ms until the CR95HF is ready.
+ */
+void CR95HF_SpiTransport::wakeUp() {
+    digitalWrite(_irqInPin, LOW);
+    delayMicroseconds(100);
+    digitalWrite(_irqInPin, HIGH);
+    delay(10);
+}
+
+// ============================================================================
+// SPI Transfers
+// ============================================================================
+
+/**
+ * @brief Take the bus and pull /SS low
+ * @return false if the bus could not be acquired (/SS left high)
+ *
+ * /SS is a plain GPIO spanning several transactions, so no other device
+ * on the bus may run a transaction until deselect().
+ */
+bool CR95HF_SpiTransport::select() {
+    if (spi_device_acquire_bus(_dev, portMAX_DELAY) != ESP_OK) return false;
+    digitalWrite(_csPin, LOW);
+    return true;
+}
+
+/**
+ * @brief Release /SS and the bus
+ */
+void CR95HF_SpiTransport::deselect() {
+    digitalWrite(_csPin, HIGH);
+    spi_device_release_bus(_dev);
+}
+
+/**
+ * @brief Run one SPI transaction (/SS handled by caller)
+ * @param tx Transmit buffer (DMA capable)
+ * @param rx Receive buffer (DMA capable, may be NULL)
+ * @param len Transfer length in bytes
+ * @param dma true to use an interrupt-driven DMA transfer (task sleeps),
+ *            false for a short polled transfer
+ * @return true if transaction succeeded
+ */
+bool CR95HF_SpiTransport::transfer(const uint8_t* tx, uint8_t* rx, size_t len, bool dma) {
+    spi_transaction_t t = {};
+    t.length = len * 8;
+    t.rxlength = rx ? len * 8 : 0;
+    t.tx_buffer = tx;
+    t.rx_buffer = rx;
+
+    esp_err_t err = dma ? spi_device_transmit(_dev, &t)
+                        : spi_device_polling_transmit(_dev, &t);
+    return err == ESP_OK;
+}
+
+/**
+ * @brief Check the ready flag
+ * @return true if a response can be read
+ */
+bool CR95HF_SpiTransport::responseReady() {
+    // IRQ_OUT is active low: high means nothing pending, no SPI needed
+    if (_irqOutPin >= 0) return digitalRead(_irqOutPin) == LOW;
+
+    _txBuf[0] = CR95HF_SPI_POLL;
+    _txBuf[1] = 0x00;
+    if (!select()) return false;
+    bool ok = transfer(_txBuf, _rxBuf, 2, false);
+    deselect();
+
+    return ok && (_rxBuf[1] & CR95HF_SPI_FLAG_READY);
+}
+
+/**
+ * @brief Read a complete response into _rxBuf
+ * @return true if a response was buffered, false if a transfer failed
+ *         (the response is dropped and the driver times out)
+ *
+ * Header (control, code, length) is a short polled transfer; the payload
+ * is a single DMA transfer into a word-aligned buffer, all under one /SS
+ * and one bus acquisition.
+ */
+bool CR95HF_SpiTransport::fetchResponse() {
+    _txBuf[0] = CR95HF_SPI_READ;
+    _txBuf[1] = 0x00;
+    _txBuf[2] = 0x00;
+
+    if (!select()) return false;
+    uint8_t hdr[3];
+    if (!transfer(_txBuf, hdr, 3, false)) {
+        deselect();
+        return false;
+    }
+
+    // Code and length just ahead of the word-aligned payload
+    _rxBuf[SPI_RX_HDR] = hdr[1];
+    _rxBuf[SPI_RX_HDR + 1] = hdr[2];
+    _rxHead = SPI_RX_HDR;
+
+    if (hdr[1] == CR95HF_CMD_ECHO) {
+        // Echo answer is a single byte, no length field
+        _rxTail = SPI_RX_HDR + 1;
+    } else {
+        uint8_t len = hdr[2];
+        _rxTail = SPI_RX_DATA + len;
+        if (len > 0) {
+            memset(_txBuf, 0, len);
+            if (!transfer(_txBuf, &_rxBuf[SPI_RX_DATA], len, true)) {
+                deselect();
+                _rxHead = _rxTail = 0;  // No truncated frame to parse
+                return false;
+            }
+        }
+    }
+    deselect();
+
+    return true;
+}
+
+// ============================================================================
+// Byte Stream
+// ============================================================================
+
+/**
+ * @brief Send a command frame (control byte 0x00 + frame)
+ * @param data Frame bytes
+ * @param len Frame length
+ */
+void CR95HF_SpiTransport::write(const uint8_t* data, size_t len) {
+    if (len > CR95HF_SPI_MAX_FRAME - 1) len = CR95HF_SPI_MAX_FRAME - 1;
+
+    _txBuf[0] = CR95HF_SPI_SEND;
+    memcpy(&_txBuf[1], data, len);
+    _rxHead = _rxTail = 0;
+
+    if (!select()) return;
+    transfer(_txBuf, NULL, len + 1, len + 1 > 8);
+    deselect();
+}
+
+/**
+ * @brief Number of response bytes ready
+ *
+ * Fetches the whole response in one go as soon as the ready flag is set.
+ */
+int CR95HF_SpiTransport::available() {
+    if (_rxHead >= _rxTail && responseReady()) fetchResponse();
+    return _rxTail - _rxHead;
+}
+
+/**
+ * @brief Read next response byte
+ */
+int CR95HF_SpiTransport::read() {
+    if (available() <= 0) return -1;
+    return _rxBuf[_rxHead++];
+}
+
+/**
+ * @brief Discard buffered and pending responses
+ */
+void CR95HF_SpiTransport::flushRx() {
+    if (responseReady()) fetchResponse();
+    _rxHead = _rxTail = 0;
+    if (_rxEvents) xSemaphoreTake(_irqSem, 0);
+}
+
+// ============================================================================
+// Event-Driven Receive
+// ============================================================================
+
+/**
+ * @brief IRQ_OUT falling edge handler
+ * @param arg Transport instance
+ */
+void IRAM_ATTR CR95HF_SpiTransport::irqOutIsr(void* arg) {
+    CR95HF_SpiTransport* self = static_cast<CR95HF_SpiTransport*>(arg);
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(self->_irqSem, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+/**
+ * @brief Block until IRQ_OUT signals a response or maxMs expires
+ * @param maxMs Maximum wait in milliseconds
+ */
+void CR95HF_SpiTransport::waitRx(uint32_t maxMs) {
+    if (!_rxEvents || available() > 0) return;
+    xSemaphoreTake(_irqSem, pdMS_TO_TICKS(maxMs) + 1);
+}
+
+/**
+ * @brief Enable or disable blocking on IRQ_OUT
+ * @param enable true for event mode, false for flag polling
+ * @return false if enable requested without an IRQ_OUT pin
+ */
+bool CR95HF_SpiTransport::setRxEvents(bool enable) {
+    if (!enable) {
+        if (_rxEvents) detachInterrupt(_irqOutPin);
+        _rxEvents = false;
+        return true;
+    }
+    if (_irqOutPin < 0) return false;
+
+    if (_irqSem == NULL) {
+        _irqSem = xSemaphoreCreateBinaryStatic(&_irqSemBuf);
+        if (_irqSem == NULL) return false;
+    }
+    attachInterruptArg(_irqOutPin, irqOutIsr, this, FALLING);
+    _rxEvents = true;
+    return true;
+}
+
+#endif  // ARDUINO_ARCH_ESP32
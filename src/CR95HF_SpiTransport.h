@@ -0,0 +1,134 @@
+/**
+ * @file    CR95HF_SpiTransport.h
+ * @brief   CR95HF SPI transport (ESP32 SPI master with DMA)
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * Drives the CR95HF over its SPI interface. Every SPI transaction starts with
+ * a control byte:
+ * - 0x00: send command frame
+ * - 0x01: reset
+ * - 0x02: read response (code, length, payload)
+ * - 0x03: poll flags (bit 3 = response ready, bit 2 = can send)
+ *
+ * Responses are only read once the ready flag (or IRQ_OUT) says they are
+ * complete, so there is no byte-level timeout guessing. Frame payloads are
+ * moved by the SPI DMA engine.
+ *
+ * Hardware connection (SPI mode):
+ * - CR95HF SSI_0 tied to VCC, SSI_1 tied to GND
+ * - SCK, MISO, MOSI, /SS as usual (SPI mode 0, max 2 MHz)
+ * - IRQ_IN (CR95HF) <- any GPIO (wake-up pulse)
+ * - IRQ_OUT (CR95HF) -> any GPIO (optional, data ready, active low)
+ *
+ * @code
+ * #include <CR95HF.h>
+ * #include <CR95HF_SpiTransport.h>
+ *
+ * CR95HF_SpiTransport spi(SPI2_HOST, 6, 5, 7, 10, 4, 3);
+ * CR95HF nfc(spi);
+ * @endcode
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#pragma once
+
+// ESP32 IDF SPI master: nothing is declared on other targets
+#if defined(ARDUINO_ARCH_ESP32)
+
+#include "CR95HF_Transport.h"
+#include <driver/spi_master.h>
+
+// ============================================================================
+// CR95HF SPI Control Bytes
+// Reference: CR95HF Datasheet Section 4.2
+// ============================================================================
+
+#define CR95HF_SPI_SEND         0x00    ///< Send command to CR95HF
+#define CR95HF_SPI_RESET        0x01    ///< Reset CR95HF
+#define CR95HF_SPI_READ         0x02    ///< Read response from CR95HF
+#define CR95HF_SPI_POLL         0x03    ///< Poll flags
+
+#define CR95HF_SPI_FLAG_READY   0x08    ///< Poll flag: response can be read
+#define CR95HF_SPI_FLAG_CANSEND 0x04    ///< Poll flag: command can be sent
+
+/// Largest SPI transfer: control byte + code + length + 255 data bytes
+#define CR95HF_SPI_MAX_FRAME    260
+
+// ============================================================================
+// CR95HF_SpiTransport - SPI Interface
+// ============================================================================
+
+/**
+ * @class   CR95HF_SpiTransport
+ * @brief   CR95HF link over an ESP32 SPI host using DMA
+ */
+class CR95HF_SpiTransport : public CR95HF_Transport {
+public:
+    /**
+     * @brief Constructor
+     * @param host SPI host (e.g. SPI2_HOST)
+     * @param sckPin SPI clock pin
+     * @param misoPin SPI MISO pin (CR95HF MISO)
+     * @param mosiPin SPI MOSI pin (CR95HF MOSI)
+     * @param csPin Chip select pin (CR95HF /SS, driven manually)
+     * @param irqInPin GPIO connected to CR95HF IRQ_IN (wake-up pulse)
+     * @param irqOutPin GPIO connected to CR95HF IRQ_OUT (-1 = poll flags)
+     * @param clockHz SPI clock (max 2 MHz)
+     */
+    CR95HF_SpiTransport(spi_host_device_t host, int sckPin, int misoPin, int mosiPin,
+                        int csPin, int irqInPin, int irqOutPin = -1,
+                        uint32_t clockHz = 2000000);
+
+    bool begin() override;
+    void write(const uint8_t* data, size_t len) override;
+    int available() override;
+    int read() override;
+    void flushRx() override;
+    void waitRx(uint32_t maxMs) override;
+    bool setRxEvents(bool enable) override;
+
+    /**
+     * @brief Send SPI reset control byte and wake the CR95HF again
+     */
+    void reset();
+
+    /**
+     * @brief Pulse IRQ_IN low (wake from power-up or IDLE)
+     */
+    void wakeUp() override;
+
+private:
+    spi_host_device_t _host;        ///< SPI host
+    int _sckPin;                    ///< SPI clock pin
+    int _misoPin;                   ///< SPI MISO pin
+    int _mosiPin;                   ///< SPI MOSI pin
+    int _csPin;                     ///< Chip select pin
+    int _irqInPin;                  ///< IRQ_IN pin
+    int _irqOutPin;                 ///< IRQ_OUT pin (-1 if unused)
+    uint32_t _clockHz;              ///< SPI clock frequency
+    spi_device_handle_t _dev;       ///< IDF SPI device handle
+
+    bool _rxEvents;                 ///< Block on IRQ_OUT in waitRx()
+    SemaphoreHandle_t _irqSem;      ///< Given from IRQ_OUT falling edge
+    StaticSemaphore_t _irqSemBuf;   ///< Static storage for _irqSem
+
+    // DMA buffers (word aligned, internal RAM)
+    alignas(4) uint8_t _txBuf[CR95HF_SPI_MAX_FRAME];
+    alignas(4) uint8_t _rxBuf[CR95HF_SPI_MAX_FRAME];
+
+    uint16_t _rxHead;               ///< Next byte in _rxBuf to hand out
+    uint16_t _rxTail;               ///< End of buffered response in _rxBuf
+
+    bool select();
+    void deselect();
+    bool transfer(const uint8_t* tx, uint8_t* rx, size_t len, bool dma);
+    bool responseReady();
+    bool fetchResponse();
+
+    static void IRAM_ATTR irqOutIsr(void* arg);
+};
+
+#endif  // ARDUINO_ARCH_ESP32
@@ -0,0 +1,129 @@
+/**
+ * @file    CR95HF_Trace.cpp
+ * @brief   Binary frame trace capture implementation
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#include "CR95HF_Trace.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+/**
+ * @brief Construct trace on caller storage
+ * @param buf Storage
+ * @param size Storage size (power of two, >= 512)
+ */
+CR95HF_Trace::CR95HF_Trace(uint8_t* buf, uint32_t size)
+    : _buf(buf), _mask(0), _head(0), _tail(0), _dropped(0)
+{
+    // Largest record (8 + 255) must always fit: refuse tiny or odd sizes
+    if (buf != NULL && size >= 512 && (size & (size - 1)) == 0) _mask = size - 1;
+}
+
+// ============================================================================
+// Ring Access
+// ============================================================================
+
+/**
+ * @brief Copy bytes into the ring at a free-running offset
+ * @return Offset after the copy
+ */
+uint32_t CR95HF_Trace::copyIn(uint32_t pos, const uint8_t* src, uint16_t n) {
+    uint32_t off = pos & _mask;
+    uint32_t first = (n < _mask + 1 - off) ? n : _mask + 1 - off;
+    memcpy(&_buf[off], src, first);
+    memcpy(_buf, src + first, n - first);
+    return pos + n;
+}
+
+/**
+ * @brief Copy bytes out of the ring at a free-running offset
+ */
+void CR95HF_Trace::copyOut(uint32_t pos, uint8_t* dst, uint16_t n) const {
+    uint32_t off = pos & _mask;
+    uint32_t first = (n < _mask + 1 - off) ? n : _mask + 1 - off;
+    memcpy(dst, &_buf[off], first);
+    memcpy(dst + first, _buf, n - first);
+}
+
+// ============================================================================
+// Producer / Consumer
+// ============================================================================
+
+/**
+ * @brief Append a record
+ * @return false if dropped
+ */
+bool CR95HF_Trace::record(uint8_t type, uint16_t timeoutMs, const uint8_t* a, uint8_t aLen,
+                          const uint8_t* b, uint8_t bLen) {
+    if (_mask == 0) return false;
+    if (aLen + bLen > 255) bLen = 255 - aLen;
+    uint8_t len = aLen + bLen;
+
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    uint32_t used = head - _tail.load(std::memory_order_acquire);
+    if (used + CR95HF_TRACE_RECORD_LEN + len > _mask + 1) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint32_t us = micros();
+    uint8_t hdr[CR95HF_TRACE_RECORD_LEN] = {
+        (uint8_t)us, (uint8_t)(us >> 8), (uint8_t)(us >> 16), (uint8_t)(us >> 24),
+        type, len, (uint8_t)timeoutMs, (uint8_t)(timeoutMs >> 8)
+    };
+    head = copyIn(head, hdr, sizeof(hdr));
+    if (aLen) head = copyIn(head, a, aLen);
+    if (bLen) head = copyIn(head, b, bLen);
+    _head.store(head, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Copy out complete records
+ * @param out Destination
+ * @param maxLen Destination size
+ * @return Bytes copied
+ */
+size_t CR95HF_Trace::read(uint8_t* out, size_t maxLen) {
+    if (_mask == 0) return 0;
+
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    uint32_t head = _head.load(std::memory_order_acquire);
+    size_t n = 0;
+
+    while (tail != head) {
+        uint8_t hdr[CR95HF_TRACE_RECORD_LEN];
+        copyOut(tail, hdr, sizeof(hdr));
+        uint16_t recLen = CR95HF_TRACE_RECORD_LEN + hdr[5];
+        if (n + recLen > maxLen) break;
+
+        copyOut(tail, &out[n], recLen);
+        n += recLen;
+        tail += recLen;
+    }
+
+    _tail.store(tail, std::memory_order_release);
+    return n;
+}
+
+/**
+ * @brief Write the file header
+ * @param out At least CR95HF_TRACE_HEADER_LEN bytes
+ * @return CR95HF_TRACE_HEADER_LEN
+ */
+size_t CR95HF_Trace::fileHeader(uint8_t* out) {
+    out[0] = 'C';
+    out[1] = '9';
+    out[2] = '5';
+    out[3] = 'T';
+    out[4] = CR95HF_TRACE_VERSION;
+    out[5] = out[6] = out[7] = 0;
+    return CR95HF_TRACE_HEADER_LEN;
+}
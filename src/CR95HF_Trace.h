@@ -0,0 +1,129 @@
+/**
+ * @file    CR95HF_Trace.h
+ * @brief   Binary frame trace capture for offline protocol analysis
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * Records every frame sent to the CR95HF and every response (or host-side
+ * timeout) with a microsecond timestamp and the timeout in use, into a
+ * caller-supplied RAM ring. Another task drains complete records with
+ * read() and streams them to SD, a socket, etc. while the reader keeps
+ * polling. extras/trace2pcapng.py turns a capture into pcapng.
+ *
+ * File format (all fields little-endian):
+ * @verbatim
+ * Header:  "C95T" (4) | version = 1 (1) | reserved = 0 (3)
+ * Record:  timestamp_us (4) | type (1) | length (1) | timeout_ms (2) | bytes
+ * @endverbatim
+ * type is a CR95HF_TraceType. For TX, bytes is the frame as written; for RX
+ * it is the response as received (code, length, payload); RX_TIMEOUT
+ * carries no bytes. timestamp_us is micros() and wraps every ~71 minutes.
+ *
+ * @code
+ * static uint8_t traceBuf[8192];
+ * CR95HF_Trace trace(traceBuf, sizeof(traceBuf));
+ * nfc.setTrace(&trace);
+ *
+ * // In a logging task:
+ * uint8_t hdr[CR95HF_TRACE_HEADER_LEN];
+ * file.write(hdr, CR95HF_Trace::fileHeader(hdr));
+ * uint8_t chunk[512];
+ * for (;;) {
+ *     size_t n = trace.read(chunk, sizeof(chunk));
+ *     if (n) file.write(chunk, n); else vTaskDelay(pdMS_TO_TICKS(20));
+ * }
+ * @endcode
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+#define CR95HF_TRACE_VERSION    1       ///< File format version
+#define CR95HF_TRACE_HEADER_LEN 8       ///< File header length
+#define CR95HF_TRACE_RECORD_LEN 8       ///< Record header length (before bytes)
+
+/**
+ * @brief Trace record types
+ */
+enum CR95HF_TraceType : uint8_t {
+    CR95HF_TRACE_TX = 1,        ///< Host -> CR95HF frame
+    CR95HF_TRACE_RX = 2,        ///< CR95HF -> host response
+    CR95HF_TRACE_RX_TIMEOUT = 3 ///< No complete response within timeout_ms
+};
+
+// ============================================================================
+// CR95HF_Trace - Frame Trace Ring
+// ============================================================================
+
+/**
+ * @class   CR95HF_Trace
+ * @brief   Lock-free single-producer/single-consumer trace record ring
+ *
+ * The driver is the only producer; one task drains with read(). When the
+ * ring is full new records are dropped (and counted), never blocking the
+ * reader.
+ */
+class CR95HF_Trace {
+public:
+    /**
+     * @brief Constructor
+     * @param buf Storage (must outlive the trace)
+     * @param size Storage size, must be a power of two (>= 512)
+     */
+    CR95HF_Trace(uint8_t* buf, uint32_t size);
+
+    /**
+     * @brief Append a record (producer side, called by the driver)
+     * @param type CR95HF_TraceType
+     * @param timeoutMs Timeout in use for the exchange
+     * @param a First byte range
+     * @param aLen First range length
+     * @param b Second byte range (may be NULL)
+     * @param bLen Second range length
+     * @return false if dropped (ring full or invalid storage)
+     */
+    bool record(uint8_t type, uint16_t timeoutMs, const uint8_t* a, uint8_t aLen,
+                const uint8_t* b = NULL, uint8_t bLen = 0);
+
+    /**
+     * @brief Copy out complete records (consumer side)
+     * @param out Destination
+     * @param maxLen Destination size
+     * @return Bytes copied (whole records only, 0 if none fit or none pending)
+     */
+    size_t read(uint8_t* out, size_t maxLen);
+
+    /**
+     * @brief Bytes waiting to be read
+     */
+    uint32_t pending() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Records dropped because the ring was full
+     */
+    uint32_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Write the file header
+     * @param out At least CR95HF_TRACE_HEADER_LEN bytes
+     * @return CR95HF_TRACE_HEADER_LEN
+     */
+    static size_t fileHeader(uint8_t* out);
+
+private:
+    uint8_t* _buf;                  ///< Ring storage
+    uint32_t _mask;                 ///< size - 1 (0 = invalid storage)
+    std::atomic<uint32_t> _head;    ///< Next write offset (producer)
+    std::atomic<uint32_t> _tail;    ///< Next read offset (consumer)
+    std::atomic<uint32_t> _dropped; ///< Records lost to a full ring (producer)
+
+    uint32_t copyIn(uint32_t pos, const uint8_t* src, uint16_t n);
+    void copyOut(uint32_t pos, uint8_t* dst, uint16_t n) const;
+};
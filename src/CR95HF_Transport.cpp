@@ -0,0 +1,116 @@
+/**
+ * @file    CR95HF_Transport.cpp
+ * @brief   CR95HF UART transport implementation
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#include "CR95HF_Transport.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+/**
+ * @brief Construct UART transport
+ * @param port HardwareSerial reference
+ * @param rxPin RX pin (from CR95HF TXD)
+ * @param txPin TX pin (to CR95HF RXD)
+ * @param baudRate Initial baud rate
+ */
+CR95HF_UartTransport::CR95HF_UartTransport(HardwareSerial& port, int rxPin, int txPin,
+                                           uint32_t baudRate)
+    : _port(&port), _rxPin(rxPin), _txPin(txPin), _baud(baudRate),
+      _rxEvents(false), _rxSem(NULL)
+{
+}
+
+// ============================================================================
+// Byte Stream
+// ============================================================================
+
+/**
+ * @brief Start UART (8N2)
+ * @return true (HardwareSerial::begin() has no failure report)
+ */
+bool CR95HF_UartTransport::begin() {
+    // CR95HF requires UART 8N2 (2 stop bits!) - critical!
+    _port->begin(_baud, SERIAL_8N2, _rxPin, _txPin);
+    return true;
+}
+
+/**
+ * @brief Send frame bytes
+ * @param data Frame bytes
+ * @param len Frame length
+ */
+void CR95HF_UartTransport::write(const uint8_t* data, size_t len) {
+    _port->write(data, len);
+}
+
+/**
+ * @brief Discard pending RX bytes and any stale RX notification
+ */
+void CR95HF_UartTransport::flushRx() {
+    while (_port->available()) _port->read();
+    if (_rxEvents) xSemaphoreTake(_rxSem, 0);
+}
+
+// ============================================================================
+// Event-Driven Receive
+// ============================================================================
+
+/**
+ * @brief Block until the RX event fires or maxMs expires
+ * @param maxMs Maximum wait in milliseconds
+ *
+ * Returns immediately in polling mode or when data is already buffered.
+ */
+void CR95HF_UartTransport::waitRx(uint32_t maxMs) {
+    if (!_rxEvents || _port->available()) return;
+
+    // +1 tick so a sub-tick remainder still reaches the deadline
+    xSemaphoreTake(_rxSem, pdMS_TO_TICKS(maxMs) + 1);
+}
+
+/**
+ * @brief Enable or disable event-driven UART receive
+ * @param enable true for event mode, false for polling mode
+ * @return true if mode applied
+ */
+bool CR95HF_UartTransport::setRxEvents(bool enable) {
+    if (!enable) {
+        _port->onReceive(NULL);
+        _rxEvents = false;
+        return true;
+    }
+
+    if (_rxSem == NULL) {
+        _rxSem = xSemaphoreCreateBinaryStatic(&_rxSemBuf);
+        if (_rxSem == NULL) return false;
+    }
+
+    // RX timeout of 2 symbols: callback fires as soon as a frame is complete
+    if (!_port->setRxTimeout(2)) return false;
+    _port->onReceive([this]() { xSemaphoreGive(_rxSem); }, true);
+    _rxEvents = true;
+    return true;
+}
+
+// ============================================================================
+// Baud Rate
+// ============================================================================
+
+/**
+ * @brief Change UART baud rate
+ * @param baud New baud rate
+ * @return true
+ */
+bool CR95HF_UartTransport::setBaudRate(uint32_t baud) {
+    _port->updateBaudRate(baud);
+    _baud = baud;
+    return true;
+}
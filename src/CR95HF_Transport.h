@@ -0,0 +1,158 @@
+/**
+ * @file    CR95HF_Transport.h
+ * @brief   Host interface abstraction for the CR95HF driver
+ * @author  B4E SRL - David Baldwin
+ * @date    November 2025
+ * @version 1.0.0
+ *
+ * The CR95HF protocol (command, length, payload / code, length, payload) is
+ * the same on every host interface. Only the way bytes get to and from the
+ * chip differs. CR95HF_Transport hides that difference so the protocol
+ * logic in CR95HF.cpp is shared:
+ *
+ * - CR95HF_UartTransport: HardwareSerial, 8N2 (SSI_0 = SSI_1 = GND)
+ * - CR95HF_SpiTransport:  ESP32 SPI master with DMA (SSI_0 = 1, SSI_1 = 0),
+ *   see CR95HF_SpiTransport.h
+ *
+ * Transports present received CR95HF responses as a byte stream, exactly
+ * like a serial port: available() / read().
+ *
+ * @copyright Copyright (c) 2025 B4E SRL. All rights reserved.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+// Off target, Arduino.h provides the FreeRTOS task / semaphore API (extras/host)
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+// ============================================================================
+// CR95HF_Transport - Abstract Host Interface
+// ============================================================================
+
+/**
+ * @class   CR95HF_Transport
+ * @brief   Byte-stream link between host and CR95HF
+ *
+ * Implement this to drive the CR95HF over another interface. Only begin(),
+ * write(), available() and read() are mandatory.
+ */
+class CR95HF_Transport {
+public:
+    virtual ~CR95HF_Transport() {}
+
+    /**
+     * @brief Start the host interface and wake the CR95HF
+     * @return true if interface started
+     */
+    virtual bool begin() = 0;
+
+    /**
+     * @brief Send a complete command frame (or the single ECHO byte)
+     * @param data Frame bytes
+     * @param len Frame length
+     */
+    virtual void write(const uint8_t* data, size_t len) = 0;
+
+    /**
+     * @brief Number of response bytes ready to read (never blocks)
+     */
+    virtual int available() = 0;
+
+    /**
+     * @brief Read next response byte
+     * @return Byte value, or -1 if none available
+     */
+    virtual int read() = 0;
+
+    /**
+     * @brief Discard any pending response bytes
+     */
+    virtual void flushRx() { while (available() > 0) read(); }
+
+    /**
+     * @brief Wait until all written bytes have left the host
+     */
+    virtual void flushTx() {}
+
+    /**
+     * @brief Block until response data may be available
+     * @param maxMs Maximum time to block in milliseconds
+     *
+     * Default returns immediately, so callers spin-poll available().
+     */
+    virtual void waitRx(uint32_t maxMs) { (void)maxMs; }
+
+    /**
+     * @brief Enable event-driven receive (see waitRx())
+     * @param enable true to block on events, false to spin-poll
+     * @return true if mode applied
+     */
+    virtual bool setRxEvents(bool enable) { return !enable; }
+
+    /**
+     * @brief Send a low pulse on CR95HF IRQ_IN (wake-up from IDLE)
+     *
+     * Default writes a 0x00 byte: in UART mode IRQ_IN is the RX line, so the
+     * start bit plus eight zero bits form the pulse.
+     */
+    virtual void wakeUp() { static const uint8_t zero = 0x00; write(&zero, 1); }
+
+    /**
+     * @brief Change host-side baud rate (UART only)
+     * @param baud New baud rate
+     * @return false if the interface has no baud rate
+     */
+    virtual bool setBaudRate(uint32_t baud) { (void)baud; return false; }
+
+    /**
+     * @brief Current host-side baud rate (0 if not applicable)
+     */
+    virtual uint32_t baudRate() const { return 0; }
+};
+
+// ============================================================================
+// CR95HF_UartTransport - HardwareSerial Interface
+// ============================================================================
+
+/**
+ * @class   CR95HF_UartTransport
+ * @brief   CR95HF UART link on an ESP32 HardwareSerial port (8N2)
+ *
+ * Used internally by the CR95HF(HardwareSerial&, ...) constructor.
+ */
+class CR95HF_UartTransport : public CR95HF_Transport {
+public:
+    /**
+     * @brief Constructor
+     * @param port HardwareSerial reference (e.g., Serial1)
+     * @param rxPin RX pin number (receives from CR95HF TXD)
+     * @param txPin TX pin number (transmits to CR95HF RXD)
+     * @param baudRate Initial baud rate (57600 after CR95HF power-up)
+     */
+    CR95HF_UartTransport(HardwareSerial& port, int rxPin, int txPin, uint32_t baudRate);
+
+    bool begin() override;
+    void write(const uint8_t* data, size_t len) override;
+    int available() override { return _port->available(); }
+    int read() override { return _port->read(); }
+    void flushRx() override;
+    void flushTx() override { _port->flush(); }
+    void waitRx(uint32_t maxMs) override;
+    bool setRxEvents(bool enable) override;
+    bool setBaudRate(uint32_t baud) override;
+    uint32_t baudRate() const override { return _baud; }
+
+private:
+    HardwareSerial* _port;          ///< Serial port reference
+    int _rxPin;                     ///< RX pin number
+    int _txPin;                     ///< TX pin number
+    uint32_t _baud;                 ///< Current baud rate
+
+    bool _rxEvents;                 ///< Event-driven receive enabled
+    SemaphoreHandle_t _rxSem;       ///< Given by UART RX event callback
+    StaticSemaphore_t _rxSemBuf;    ///< Static storage for _rxSem
+};